@@ -0,0 +1,168 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Minimal micro benchmark harness, self contained so the benchmarks build anywhere the
+// examples do.
+//
+//   bench::Runner run(argc, argv);
+//   run.add("tensor/transpose/1024x1024", n, [&] { t.transpose({1, 0}); });
+//
+// Each case is warmed up, then timed for a number of repetitions. A repetition runs the case
+// enough times to last at least --min-time so the clock resolution doesn't matter. Per call
+// median, p95 and throughput (elements per second) are reported on stderr and as JSON.
+//
+// Options: --filter <substring> --repetitions <n> --min-time <ms> --json <file>
+namespace bench {
+
+// keep the compiler from discarding a computed value
+template <class T>
+inline void do_not_optimize(const T& val) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(val) : "memory");
+#else
+    static volatile char sink;
+    sink = *reinterpret_cast<const volatile char*>(&val);
+#endif
+}
+
+struct Result {
+    std::string name;
+    size_t elements;
+    size_t repetitions;
+    size_t iterations;
+    double median_ns;
+    double p95_ns;
+    double min_ns;
+    double elements_per_second;
+};
+
+class Runner {
+    typedef std::chrono::steady_clock clock;
+
+    std::string _binary, _filter, _json;
+    size_t _repetitions;
+    double _min_time_ns;
+    std::vector<Result> _results;
+
+    static double percentile(std::vector<double> v, double p) {
+        std::sort(v.begin(), v.end());
+        const size_t i = static_cast<size_t>(p * (v.size() - 1) + 0.5);
+        return v[std::min(i, v.size() - 1)];
+    }
+
+    template <class F>
+    static double time_batch(F& f, size_t iterations) {
+        const auto start = clock::now();
+        for (size_t i = 0; i < iterations; i++)
+            f();
+        return std::chrono::duration<double, std::nano>(clock::now() - start).count();
+    }
+
+    static std::string escape(const std::string& s) {
+        std::string out;
+        for (char c : s) {
+            if (c == '"' || c == '\\')
+                out += '\\';
+            out += c;
+        }
+        return out;
+    }
+
+public:
+    Runner(int argc, char** argv) : _repetitions(15), _min_time_ns(2e6) {
+        _binary = argc ? argv[0] : "bench";
+        const auto slash = _binary.find_last_of("/\\");
+        if (slash != std::string::npos)
+            _binary = _binary.substr(slash + 1);
+        for (int i = 1; i + 1 < argc; i += 2) {
+            const std::string key = argv[i], val = argv[i + 1];
+            if (key == "--filter")
+                _filter = val;
+            else if (key == "--repetitions")
+                _repetitions = std::max<size_t>(1, std::strtoul(val.c_str(), nullptr, 10));
+            else if (key == "--min-time")
+                _min_time_ns = std::strtod(val.c_str(), nullptr) * 1e6;
+            else if (key == "--json")
+                _json = val;
+            else
+                std::cerr << "unknown option " << key << '\n';
+        }
+    }
+
+    // results go to stdout, or to the --json file
+    ~Runner() {
+        if (_json.empty()) {
+            std::cout << json();
+        } else {
+            std::ofstream f(_json);
+            f << json();
+        }
+    }
+
+    // f performs one call processing `elements` items
+    template <class F>
+    void add(const std::string& name, size_t elements, F&& f) {
+        if (!_filter.empty() && name.find(_filter) == std::string::npos)
+            return;
+
+        // warmup doubles the batch until it lasts a tenth of min time, which also sizes the
+        // batches of the timed repetitions
+        size_t iterations = 1;
+        double ns = time_batch(f, iterations);
+        while (ns < _min_time_ns / 10 && iterations < (size_t(1) << 30)) {
+            iterations *= 2;
+            ns = time_batch(f, iterations);
+        }
+        const double scale = _min_time_ns / std::max(ns, 1.0);
+        iterations = std::max<size_t>(1, static_cast<size_t>(iterations * scale));
+
+        std::vector<double> samples(_repetitions);
+        for (auto& s : samples)
+            s = time_batch(f, iterations) / iterations;
+
+        Result r;
+        r.name = name;
+        r.elements = elements;
+        r.repetitions = _repetitions;
+        r.iterations = iterations;
+        r.median_ns = percentile(samples, 0.5);
+        r.p95_ns = percentile(samples, 0.95);
+        r.min_ns = *std::min_element(samples.begin(), samples.end());
+        r.elements_per_second = r.median_ns > 0 ? elements * 1e9 / r.median_ns : 0;
+        _results.push_back(r);
+
+        char line[256];
+        std::snprintf(line, sizeof(line), "%-48s %14.1f ns %14.1f ns %12.4g elem/s\n",
+                      name.c_str(), r.median_ns, r.p95_ns, r.elements_per_second);
+        std::cerr << line;
+    }
+
+    std::string json() const {
+        std::ostringstream os;
+        os.precision(6);
+        os << std::fixed;
+        os << "{\n  \"binary\": \"" << escape(_binary) << "\",\n  \"results\": [";
+        for (size_t i = 0; i < _results.size(); i++) {
+            const auto& r = _results[i];
+            os << (i ? "," : "") << "\n    {\"name\": \"" << escape(r.name)
+               << "\", \"elements\": " << r.elements << ", \"repetitions\": " << r.repetitions
+               << ", \"iterations\": " << r.iterations << ", \"median_ns\": " << r.median_ns
+               << ", \"p95_ns\": " << r.p95_ns << ", \"min_ns\": " << r.min_ns
+               << ", \"elements_per_second\": " << r.elements_per_second << "}";
+        }
+        os << "\n  ]\n}\n";
+        return os.str();
+    }
+};
+
+} // namespace bench
@@ -0,0 +1,65 @@
+#include "bench.hpp"
+#include "shol/io/binary.hpp"
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace shol;
+
+template <class T>
+std::string snapshot(const T& val) {
+    std::ostringstream os;
+    BinaryWriter out(os);
+    out << val;
+    out.flush();
+    return os.str();
+}
+
+template <class T>
+void round_trip(bench::Runner& run, const std::string& name, const T& val, size_t n) {
+    run.add("binary/write/" + name, n, [&] {
+        std::ostringstream os;
+        BinaryWriter out(os);
+        out << val;
+        out.flush();
+        bench::do_not_optimize(os.tellp());
+    });
+
+    const auto bytes = snapshot(val);
+    run.add("binary/read/" + name, n, [&] {
+        BinaryReader in(bytes.data(), bytes.size());
+        T copy;
+        in >> copy;
+        bench::do_not_optimize(copy.size());
+    });
+}
+
+int main(int argc, char** argv) {
+    bench::Runner run(argc, argv);
+
+    std::mt19937_64 rng(17);
+    for (size_t n : {1 << 10, 1 << 20}) {
+        std::vector<double> v(n);
+        for (auto& x : v)
+            x = static_cast<double>(rng());
+        round_trip(run, "vector<double>/" + std::to_string(n), v, n);
+
+        const auto bytes = snapshot(v);
+        run.add("binary/read_view/vector<double>/" + std::to_string(n), n, [&] {
+            BinaryReader in(bytes.data(), bytes.size());
+            bench::do_not_optimize(in.read_view<double>().size());
+        });
+    }
+
+    std::map<int, std::vector<int>> m;
+    for (int i = 0; i < 4096; i++)
+        m[i] = std::vector<int>(16, i);
+    round_trip(run, "map<int,vector<int>>/4096", m, m.size());
+
+    std::vector<std::pair<int, int>> pairs(1 << 16);
+    for (auto& p : pairs)
+        p = {static_cast<int>(rng()), static_cast<int>(rng())};
+    round_trip(run, "vector<pair<int,int>>/65536", pairs, pairs.size());
+}
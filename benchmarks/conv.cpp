@@ -0,0 +1,52 @@
+#include "bench.hpp"
+#include "shol/math/conv.hpp"
+#include <string>
+
+using namespace shol;
+
+tensor<float> ramp(const shape& s) {
+    tensor<float> t(s);
+    float c = 0;
+    t.apply([&](float) { return c = c < 1 ? c + 0.001f : -1; });
+    return t;
+}
+
+int main(int argc, char** argv) {
+    bench::Runner run(argc, argv);
+
+    // (input, kernel) per case, the first three take the direct path, the last im2col
+    const shape signal{8, 4, 4096};
+    const auto x = ramp(signal);
+    const auto taps5 = ramp({8, 4, 5});
+    run.add("conv/conv1d/8x4x4096/5tap", 8 * 8 * 4096, [&] {
+        auto y = conv1d(x, taps5, {1, 2});
+        bench::do_not_optimize(*y.begin());
+    });
+
+    const auto img = ramp({4, 16, 64, 64});
+    const auto k3 = ramp({16, 16, 3, 3});
+    const size_t out = 4 * 16 * 64 * 64;
+    run.add("conv/conv2d/4x16x64x64/3x3", out, [&] {
+        auto y = conv2d(img, k3, {1, 1});
+        bench::do_not_optimize(*y.begin());
+    });
+    run.add("conv/conv2d/4x16x64x64/3x3/stride2", out / 4, [&] {
+        auto y = conv2d(img, k3, {2, 1});
+        bench::do_not_optimize(*y.begin());
+    });
+
+    const auto k7 = ramp({16, 16, 7, 7});
+    run.add("conv/conv2d/4x16x64x64/7x7", out, [&] {
+        auto y = conv2d(img, k7, {1, 3});
+        bench::do_not_optimize(*y.begin());
+    });
+
+    run.add("conv/max_pool2d/4x16x64x64/2x2", out / 4, [&] {
+        auto y = max_pool2d(img, 2);
+        bench::do_not_optimize(*y.begin());
+    });
+    run.add("conv/avg_pool2d/4x16x64x64/3x3", out, [&] {
+        auto y = avg_pool2d(img, 3, {1, 1});
+        bench::do_not_optimize(*y.begin());
+    });
+}
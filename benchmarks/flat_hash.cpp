@@ -0,0 +1,76 @@
+#include "bench.hpp"
+#include "shol/ds/FlatHashMap.hpp"
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace shol;
+
+template <class Map>
+void map_ops(bench::Runner& run, const std::string& name, const std::vector<uint64_t>& keys,
+             const std::vector<uint64_t>& misses) {
+    const auto n = std::to_string(keys.size());
+    run.add(name + "/insert/" + n, keys.size(), [&] {
+        Map m;
+        for (const auto& k : keys)
+            m[k] = k;
+        bench::do_not_optimize(m.size());
+    });
+
+    run.add(name + "/insert_reserved/" + n, keys.size(), [&] {
+        Map m;
+        m.reserve(keys.size());
+        for (const auto& k : keys)
+            m[k] = k;
+        bench::do_not_optimize(m.size());
+    });
+
+    Map m;
+    for (const auto& k : keys)
+        m[k] = k;
+    run.add(name + "/find_hit/" + n, keys.size(), [&] {
+        uint64_t sum = 0;
+        for (const auto& k : keys)
+            sum += m.find(k)->second;
+        bench::do_not_optimize(sum);
+    });
+
+    run.add(name + "/find_miss/" + n, misses.size(), [&] {
+        size_t found = 0;
+        for (const auto& k : misses)
+            found += m.count(k);
+        bench::do_not_optimize(found);
+    });
+
+    run.add(name + "/erase_insert/" + n, keys.size(), [&] {
+        for (const auto& k : keys) {
+            m.erase(k);
+            m[k] = k;
+        }
+        bench::do_not_optimize(m.size());
+    });
+
+    run.add(name + "/iterate/" + n, keys.size(), [&] {
+        uint64_t sum = 0;
+        for (const auto& kv : m)
+            sum += kv.second;
+        bench::do_not_optimize(sum);
+    });
+}
+
+int main(int argc, char** argv) {
+    bench::Runner run(argc, argv);
+
+    std::mt19937_64 rng(7);
+    for (size_t n : {1 << 10, 1 << 16, 1 << 20}) {
+        std::vector<uint64_t> keys(n), misses(n);
+        for (size_t i = 0; i < n; i++) {
+            keys[i] = rng() | 1;
+            misses[i] = rng() & ~uint64_t(1);
+        }
+        map_ops<FlatHashMap<uint64_t, uint64_t>>(run, "FlatHashMap", keys, misses);
+        map_ops<std::unordered_map<uint64_t, uint64_t, Hash<uint64_t>>>(run, "unordered_map",
+                                                                         keys, misses);
+    }
+}
@@ -0,0 +1,46 @@
+#include "bench.hpp"
+#include "shol/math/gcd.hpp"
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace shol;
+
+template <class T>
+T euclid(T u, T v) {
+    while (v) {
+        T t = u % v;
+        u = v;
+        v = t;
+    }
+    return u;
+}
+
+template <class T>
+void gcd_pairs(bench::Runner& run, const std::string& name, size_t n) {
+    std::mt19937_64 rng(3);
+    std::vector<std::pair<T, T>> pairs(n);
+    for (auto& p : pairs)
+        p = {static_cast<T>(rng()), static_cast<T>(rng())};
+
+    run.add("gcd/GCD<" + name + ">/" + std::to_string(n), n, [&] {
+        T sum = 0;
+        for (const auto& p : pairs)
+            sum += GCD(p.first, p.second);
+        bench::do_not_optimize(sum);
+    });
+
+    run.add("gcd/euclid<" + name + ">/" + std::to_string(n), n, [&] {
+        T sum = 0;
+        for (const auto& p : pairs)
+            sum += euclid(p.first, p.second);
+        bench::do_not_optimize(sum);
+    });
+}
+
+int main(int argc, char** argv) {
+    bench::Runner run(argc, argv);
+    gcd_pairs<uint32_t>(run, "uint32_t", 1 << 12);
+    gcd_pairs<uint64_t>(run, "uint64_t", 1 << 12);
+}
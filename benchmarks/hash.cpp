@@ -0,0 +1,86 @@
+#include "bench.hpp"
+#include "shol/algo/hash.hpp"
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace shol;
+
+// tile corners of a large map, the layout that makes CantorHash chain in power-of-two tables
+std::vector<std::pair<int, int>> grid_keys(int side, int stride) {
+    std::vector<std::pair<int, int>> keys;
+    for (int x = -side; x < side; x += stride)
+        for (int y = -side; y < side; y += stride)
+            keys.emplace_back(x, y);
+    return keys;
+}
+
+template <class Hasher>
+void hash_keys(bench::Runner& run, const std::string& name,
+               const std::vector<std::pair<int, int>>& keys) {
+    Hasher hasher;
+    run.add("hash/" + name + "/" + std::to_string(keys.size()), keys.size(), [&] {
+        size_t sum = 0;
+        for (const auto& k : keys)
+            sum += hasher(k);
+        bench::do_not_optimize(sum);
+    });
+}
+
+template <class Hasher>
+void map_keys(bench::Runner& run, const std::string& name,
+              const std::vector<std::pair<int, int>>& keys) {
+    const auto n = std::to_string(keys.size());
+    run.add("unordered_map<" + name + ">/insert/" + n, keys.size(), [&] {
+        std::unordered_map<std::pair<int, int>, int, Hasher> m;
+        for (const auto& k : keys)
+            m[k] = 1;
+        bench::do_not_optimize(m.size());
+    });
+
+    std::unordered_map<std::pair<int, int>, int, Hasher> m;
+    for (const auto& k : keys)
+        m[k] = 1;
+    run.add("unordered_map<" + name + ">/find/" + n, keys.size(), [&] {
+        size_t found = 0;
+        for (const auto& k : keys)
+            found += m.count(k);
+        bench::do_not_optimize(found);
+    });
+}
+
+int main(int argc, char** argv) {
+    bench::Runner run(argc, argv);
+
+    for (int side : {64, 1024}) {
+        const auto dense = grid_keys(side, 1);
+        hash_keys<CantorHash>(run, "CantorHash/dense", dense);
+        hash_keys<Hash<std::pair<int, int>>>(run, "Hash<pair>/dense", dense);
+    }
+
+    const auto strided = grid_keys(1 << 14, 64);
+    map_keys<CantorHash>(run, "CantorHash", strided);
+    map_keys<Hash<std::pair<int, int>>>(run, "Hash<pair>", strided);
+
+    std::mt19937 rng(42);
+    for (size_t len : {8, 32, 256}) {
+        std::string s(len, 'x');
+        for (auto& c : s)
+            c = static_cast<char>('a' + rng() % 26);
+        Hash<std::string> hasher;
+        std::hash<std::string> std_hasher;
+        run.add("hash/Hash<string>/" + std::to_string(len), len,
+                [&] { bench::do_not_optimize(hasher(s)); });
+        run.add("hash/std::hash<string>/" + std::to_string(len), len,
+                [&] { bench::do_not_optimize(std_hasher(s)); });
+    }
+
+    std::vector<int> v(1024);
+    for (auto& x : v)
+        x = static_cast<int>(rng());
+    Hash<std::vector<int>> vector_hasher;
+    run.add("hash/Hash<vector<int>>/1024", v.size(),
+            [&] { bench::do_not_optimize(vector_hasher(v)); });
+}
@@ -0,0 +1,50 @@
+#include "bench.hpp"
+#include "shol/math/mod.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace shol;
+
+constexpr long long MOD = 1000000007;
+typedef Modular<long long, MOD> mint;
+
+int main(int argc, char** argv) {
+    bench::Runner run(argc, argv);
+
+    std::mt19937_64 rng(1);
+    for (size_t n : {1 << 10, 1 << 16}) {
+        std::vector<mint> v;
+        for (size_t i = 0; i < n; i++)
+            v.emplace_back(static_cast<long long>(rng() % MOD));
+
+        run.add("mod/multiply/" + std::to_string(n), n, [&] {
+            mint p(1);
+            for (const auto& x : v)
+                p *= x;
+            bench::do_not_optimize(p);
+        });
+
+        run.add("mod/add/" + std::to_string(n), n, [&] {
+            mint s(0);
+            for (const auto& x : v)
+                s += x;
+            bench::do_not_optimize(s);
+        });
+    }
+
+    std::vector<mint> bases;
+    for (size_t i = 0; i < 64; i++)
+        bases.emplace_back(static_cast<long long>(rng() % MOD));
+    for (long long e : {1000LL, MOD - 2, 1000000000000000000LL}) {
+        run.add("mod/pow/e=" + std::to_string(e), bases.size(), [&] {
+            for (const auto& b : bases)
+                bench::do_not_optimize(pow(b, e));
+        });
+    }
+
+    run.add("mod/inv", bases.size(), [&] {
+        for (const auto& b : bases)
+            bench::do_not_optimize(inv(b));
+    });
+}
@@ -0,0 +1,35 @@
+#include "bench.hpp"
+#include "shol/io/printer.hpp"
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace shol;
+
+int main(int argc, char** argv) {
+    bench::Runner run(argc, argv);
+
+    std::mt19937 rng(11);
+    for (size_t n : {1 << 10, 1 << 16}) {
+        std::vector<int> v(n);
+        for (auto& x : v)
+            x = static_cast<int>(rng());
+        run.add("printer/vector<int>/" + std::to_string(n), n, [&] {
+            std::ostringstream os;
+            os << v;
+            bench::do_not_optimize(os.tellp());
+        });
+
+        std::map<std::string, std::pair<int, double>> m;
+        for (size_t i = 0; i < n; i++)
+            m[std::to_string(rng())] = {static_cast<int>(i), i * 0.5};
+        run.add("printer/map<string,pair<int,double>>/" + std::to_string(m.size()), m.size(),
+                [&] {
+                    std::ostringstream os;
+                    os << m;
+                    bench::do_not_optimize(os.tellp());
+                });
+    }
+}
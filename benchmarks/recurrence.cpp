@@ -0,0 +1,56 @@
+#include "bench.hpp"
+#include "shol/math/recurrence.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace shol;
+
+constexpr long long MOD = 1000000007;
+typedef Modular<long long, MOD> mint;
+
+int main(int argc, char** argv) {
+    bench::Runner run(argc, argv);
+
+    std::mt19937_64 rng(1);
+    const uint64_t n = 1000000000000000000ULL;
+    for (size_t k : {2, 16, 64}) {
+        const auto name = std::to_string(k);
+        std::vector<mint> c, a;
+        for (size_t i = 0; i < k; i++) {
+            c.emplace_back(static_cast<long long>(rng() % MOD));
+            a.emplace_back(static_cast<long long>(rng() % MOD));
+        }
+        const LinearRecurrence<long long, MOD> rec(c, a);
+        const auto m = rec.matrix();
+
+        // Modular scalars with a % per multiply-accumulate, the baseline for the lazy product
+        std::vector<mint> x(k * k, mint(0));
+        for (size_t i = 0; i < k; i++)
+            for (size_t j = 0; j < k; j++)
+                x[i * k + j] = m(i, j) + mint(static_cast<long long>(i + j));
+        run.add("recurrence/multiply/modular/k=" + name, k * k * k, [&] {
+            std::vector<mint> y(k * k, mint(0));
+            for (size_t i = 0; i < k; i++)
+                for (size_t t = 0; t < k; t++)
+                    for (size_t j = 0; j < k; j++)
+                        y[i * k + j] += x[i * k + t] * x[t * k + j];
+            bench::do_not_optimize(y[0]);
+        });
+
+        ModMatrix<long long, MOD> mx(k, k);
+        for (size_t i = 0; i < k * k; i++)
+            mx.set(i / k, i % k, x[i]);
+        run.add("recurrence/multiply/lazy/k=" + name, k * k * k, [&] {
+            auto y = mx * mx;
+            bench::do_not_optimize(y(0, 0));
+        });
+
+        run.add("recurrence/matrix_pow/k=" + name, 1, [&] {
+            auto p = pow(m, n);
+            bench::do_not_optimize(p(0, 0));
+        });
+
+        run.add("recurrence/kitamasa/k=" + name, 1, [&] { bench::do_not_optimize(rec[n]); });
+    }
+}
@@ -0,0 +1,26 @@
+#include "bench.hpp"
+#include "shol/ds/RunningArray.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace shol;
+
+int main(int argc, char** argv) {
+    bench::Runner run(argc, argv);
+
+    std::mt19937 rng(5);
+    std::vector<long long> values(1 << 16);
+    for (auto& x : values)
+        x = rng() % 1000;
+
+    for (size_t window : {16, 1024, 1 << 16}) {
+        RunningArray<long long> ra(window);
+        run.add("RunningArray::next/window=" + std::to_string(window), values.size(), [&] {
+            long long sum = 0;
+            for (const auto& x : values)
+                sum += ra.next(x);
+            bench::do_not_optimize(sum);
+        });
+    }
+}
@@ -0,0 +1,85 @@
+#include "bench.hpp"
+#include "shol/io/printer.hpp"
+#include "shol/io/scanner.hpp"
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace shol;
+
+template <class T>
+std::string to_text(const T& val) {
+    std::ostringstream os;
+    os << val;
+    return os.str();
+}
+
+template <class T>
+std::string to_plain(const std::vector<T>& v) {
+    std::ostringstream os;
+    os.precision(17);
+    for (const auto& x : v)
+        os << x << ' ';
+    return os.str();
+}
+
+int main(int argc, char** argv) {
+    bench::Runner run(argc, argv);
+
+    std::mt19937_64 rng(13);
+    const size_t n = 1 << 16;
+    const auto size = std::to_string(n);
+
+    std::vector<long long> ints(n);
+    for (auto& x : ints)
+        x = static_cast<long long>(rng() >> (rng() % 64));
+    const auto int_text = to_plain(ints);
+    run.add("scanner/read_vector<long long>/" + size, n, [&] {
+        Scanner in(int_text.data(), int_text.size());
+        bench::do_not_optimize(in.read_vector<long long>(n).back());
+    });
+    run.add("istringstream/long long/" + size, n, [&] {
+        std::istringstream in(int_text);
+        long long x = 0;
+        for (size_t i = 0; i < n; i++)
+            in >> x;
+        bench::do_not_optimize(x);
+    });
+
+    std::vector<double> doubles(n);
+    for (auto& x : doubles)
+        x = static_cast<double>(rng() % 1000000) / 1000;
+    const auto double_text = to_plain(doubles);
+    run.add("scanner/read_vector<double>/" + size, n, [&] {
+        Scanner in(double_text.data(), double_text.size());
+        bench::do_not_optimize(in.read_vector<double>(n).back());
+    });
+    run.add("istringstream/double/" + size, n, [&] {
+        std::istringstream in(double_text);
+        double x = 0;
+        for (size_t i = 0; i < n; i++)
+            in >> x;
+        bench::do_not_optimize(x);
+    });
+
+    std::vector<std::vector<int>> nested(256, std::vector<int>(256));
+    for (auto& row : nested)
+        for (auto& x : row)
+            x = static_cast<int>(rng() % 100000);
+    const auto nested_text = to_text(nested);
+    run.add("scanner/vector<vector<int>>/256x256", 256 * 256, [&] {
+        Scanner in(nested_text.data(), nested_text.size());
+        bench::do_not_optimize(in.read<std::vector<std::vector<int>>>().size());
+    });
+
+    std::map<std::string, int> dict;
+    for (size_t i = 0; i < 4096; i++)
+        dict[std::to_string(rng())] = static_cast<int>(i);
+    const auto dict_text = to_text(dict);
+    run.add("scanner/map<string,int>/4096", dict.size(), [&] {
+        Scanner in(dict_text.data(), dict_text.size());
+        bench::do_not_optimize(in.read<std::map<std::string, int>>().size());
+    });
+}
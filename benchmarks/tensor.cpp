@@ -0,0 +1,70 @@
+#include "bench.hpp"
+#include "shol/math/tensor.hpp"
+#include <string>
+#include <vector>
+
+using namespace shol;
+
+std::string dims(const shape& s) {
+    std::string out;
+    for (size_t i = 0; i < s.size(); i++)
+        out += (i ? "x" : "") + std::to_string(s[i]);
+    return out;
+}
+
+int main(int argc, char** argv) {
+    bench::Runner run(argc, argv);
+
+    for (const shape& s : {shape{64, 64}, shape{1024, 1024}, shape{64, 64, 64}}) {
+        const auto name = dims(s);
+        tensor<float> t(s);
+        const auto n = t.size();
+        float c = 0;
+        t.apply([&](float) { return c += 1; });
+
+        std::vector<size_t> perm(s.size());
+        for (size_t i = 0; i < perm.size(); i++)
+            perm[i] = (i + 1) % perm.size();
+        run.add("tensor/transpose/" + name, n, [&] {
+            t.transpose(perm);
+            bench::do_not_optimize(*t.begin());
+        });
+
+        run.add("tensor/copy/" + name, n, [&] {
+            tensor<float> copy(t);
+            bench::do_not_optimize(*copy.begin());
+        });
+
+        run.add("tensor/fill_value/" + name, n, [&] {
+            t.fill(1.0f);
+            bench::do_not_optimize(*t.begin());
+        });
+
+        const std::vector<float> pattern(n / 4 + 1, 2.0f);
+        run.add("tensor/fill_vector/" + name, n, [&] {
+            t.fill(pattern);
+            bench::do_not_optimize(*t.begin());
+        });
+
+        const std::vector<float> data(n, 3.0f);
+        run.add("tensor/from_vector/" + name, n, [&] {
+            auto u = tensor<float>::from_vector(data, s);
+            bench::do_not_optimize(*u.begin());
+        });
+
+        run.add("tensor/apply/" + name, n, [&] {
+            t.apply([](float x) { return x * 0.5f + 1.0f; });
+            bench::do_not_optimize(*t.begin());
+        });
+
+        if (s.size() == 2) {
+            run.add("tensor/operator[]/" + name, n, [&] {
+                float sum = 0;
+                for (shapeType i = 0; i < s[0]; i++)
+                    for (shapeType j = 0; j < s[1]; j++)
+                        sum += t[{i, j}];
+                bench::do_not_optimize(sum);
+            });
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#include "shol/io/binary.hpp"
+#include "shol/io/printer.hpp"
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+int main() {
+    using namespace std;
+    using namespace shol;
+
+    map<string, vector<int>> index = {{"even", {0, 2, 4}}, {"odd", {1, 3, 5}}};
+    tensor<float> weights = tensor<float>::from_vector({0.5f, 1.5f, 2.5f, 3.5f}, {2, 2});
+    vector<double> samples(1000, 0.25);
+
+    // snapshot, use an ofstream opened with ios::binary for files
+    ostringstream os;
+    {
+        BinaryWriter out(os);
+        out << index << weights << samples;
+        cout << "bytes written: " << out.offset() << endl;
+    }
+
+    // BinaryReader(path) memory maps the file instead
+    const string bytes = os.str();
+    BinaryReader in(bytes.data(), bytes.size());
+    map<string, vector<int>> index2;
+    tensor<float> weights2({1});
+    in >> index2 >> weights2;
+    auto view = in.read_view<double>();
+
+    cout << "map<string, vector<int>>: " << index2 << endl;
+    cout << "tensor<float> " << weights2.get_shape() << ":\n" << weights2 << endl;
+    cout << "view size: " << view.size() << ", view[999]: " << view[999] << endl;
+    cout << "eof: " << in.eof() << endl;
+}
+
+/*
+Expected Output:
+===============
+bytes written: 8120
+map<string, vector<int>>: {(even, {0, 2, 4}), (odd, {1, 3, 5})}
+tensor<float> (2 2):
+[[0.5 1.5]
+ [2.5 3.5]]
+view size: 1000, view[999]: 0.25
+eof: 1
+*/
@@ -0,0 +1,60 @@
+#include "shol/io/printer.hpp"
+#include "shol/math/conv.hpp"
+#include <iostream>
+#include <vector>
+
+int main() {
+    using namespace std;
+    using namespace shol;
+
+    // 2 channel signal of length 8, moving sum and difference filters
+    vector<float> signal = {1, 2, 3, 4, 5, 6, 7, 8, 8, 7, 6, 5, 4, 3, 2, 1};
+    auto x = tensor<float>::from_vector(signal, {2, 8});
+    auto k = tensor<float>::from_vector({1, 1, 1, 0, 0, 0, 0, 0, 0, 1, 0, -1}, {2, 2, 3});
+    auto y = conv1d(x, k, {1, 1}, {0.0f, 0.5f});
+    cout << "conv1d " << y.get_shape() << ":\n" << y << endl;
+
+    // batch of one 4x4 image, 3x3 box blur with stride 1 and 2
+    vector<float> image(16);
+    for (size_t i = 0; i < image.size(); i++)
+        image[i] = static_cast<float>(i);
+    auto img = tensor<float>::from_vector(image, {1, 1, 4, 4});
+    tensor<float> box({1, 1, 3, 3});
+    box.fill(1.0f / 9);
+    cout << "blur " << conv2d(img, box, {1, 1}).get_shape() << endl;
+    cout << "strided blur:\n" << conv2d(img, box, {2, 1}) << endl;
+
+    // dilated 2x2 kernel reads the corners of a 3x3 window
+    auto corners = tensor<float>::from_vector({1, 1, 1, 1}, {1, 1, 2, 2});
+    cout << "dilated:\n" << conv2d(img, corners, {1, 0, 2}) << endl;
+
+    cout << "max_pool2d:\n" << max_pool2d(img, 2) << endl;
+    cout << "avg_pool2d:\n" << avg_pool2d(img, 3, {1, 1}) << endl;
+    cout << "max_pool1d:\n" << max_pool1d(x, 3, {2, 1}) << endl;
+}
+
+/*
+Expected Output:
+===============
+conv1d (2 8):
+[[3 6 9 12 15 18 21 15]
+ [-6.5 2.5 2.5 2.5 2.5 2.5 2.5 2.5]]
+blur (1 1 4 4)
+strided blur:
+[[[[1.11111 2.66667]
+   [5.66667 10]]]]
+dilated:
+[[[[20 24]
+   [36 40]]]]
+max_pool2d:
+[[[[5 7]
+   [13 15]]]]
+avg_pool2d:
+[[[[2.5 3 4 4.5]
+   [4.5 5 6 6.5]
+   [8.5 9 10 10.5]
+   [10.5 11 12 12.5]]]]
+max_pool1d:
+[[2 4 6 8]
+ [8 7 5 3]]
+*/
@@ -0,0 +1,38 @@
+#include "shol/ds/FlatHashMap.hpp"
+#include "shol/ds/FlatHashSet.hpp"
+#include "shol/io/printer.hpp"
+#include <iostream>
+#include <string>
+
+int main() {
+    using namespace std;
+    using namespace shol;
+
+    FlatHashMap<pair<int, int>, string> grid;
+    grid.reserve(100);
+    grid[{0, 0}] = "origin";
+    grid[{-3, 7}] = "tree";
+    grid.try_emplace({-3, 7}, "rock");
+    cout << "grid.size() = " << grid.size() << endl;
+    cout << "grid.at((-3, 7)) = " << grid.at({-3, 7}) << endl;
+    cout << "grid.count((1, 1)) = " << grid.count({1, 1}) << endl;
+
+    grid.erase({0, 0});
+    cout << "grid = " << grid << endl;
+
+    // heterogeneous lookup with a transparent hasher and comparator
+    FlatHashSet<string, Hash<>, equal_to<>> words = {"apple", "banana"};
+    cout << "words.contains(\"apple\") = " << words.contains("apple") << endl;
+    cout << "words.contains(\"cherry\") = " << words.contains("cherry") << endl;
+}
+
+/*
+Expected Output:
+===============
+grid.size() = 2
+grid.at((-3, 7)) = tree
+grid.count((1, 1)) = 0
+grid = {((-3, 7), tree)}
+words.contains("apple") = 1
+words.contains("cherry") = 0
+*/
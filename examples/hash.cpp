@@ -0,0 +1,51 @@
+#include "shol/algo/hash.hpp"
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+template <class Hasher>
+void bucket_stats(const char* name, int side, int stride, size_t buckets) {
+    std::vector<size_t> load(buckets, 0);
+    Hasher hasher;
+    for (int x = -side; x < side; x += stride)
+        for (int y = -side; y < side; y += stride)
+            load[hasher(std::make_pair(x, y)) & (buckets - 1)]++;
+    const auto used = buckets - std::count(load.begin(), load.end(), 0);
+    std::cout << name << ": used buckets = " << used << ", longest chain = "
+              << *std::max_element(load.begin(), load.end()) << std::endl;
+}
+
+int main() {
+    using namespace std;
+    using namespace shol;
+
+    // 512x512 tile corners (stride 64) of a 32768x32768 map into 2^18 buckets
+    bucket_stats<CantorHash>("CantorHash", 1 << 14, 64, 1 << 18);
+    bucket_stats<Hash<pair<int, int>>>("Hash<pair<int, int>>", 1 << 14, 64, 1 << 18);
+
+    unordered_map<pair<int, int>, string, Hash<pair<int, int>>> grid;
+    grid[{100000, -100000}] = "far";
+    cout << "grid[(100000, -100000)] = " << grid[{100000, -100000}] << endl;
+
+    Hash<> hasher;
+    cout << boolalpha;
+    cout << "tuple hashes equal: "
+         << (hasher(make_tuple(1, 2.0, string("a"))) == hasher(make_tuple(1, 2.0, string("a"))))
+         << endl;
+    cout << "nested hashes differ: "
+         << (hasher(vector<vector<int>>{{1}, {2}}) != hasher(vector<vector<int>>{{1, 2}}))
+         << endl;
+}
+
+/*
+Expected Output:
+===============
+CantorHash: used buckets = 5860, longest chain = 149
+Hash<pair<int, int>>: used buckets = 165628, longest chain = 8
+grid[(100000, -100000)] = far
+tuple hashes equal: true
+nested hashes differ: true
+*/
@@ -0,0 +1,41 @@
+// needs SHOL_INSTRUMENT defined for the whole target, CMakeLists.txt does that for this
+// example, elsewhere configure with -DSHOL_INSTRUMENT=ON
+#include "shol/math/tensor.hpp"
+#include <iostream>
+#include <vector>
+
+int main() {
+    using namespace std;
+    using namespace shol;
+
+    vector<float> data(64 * 32, 1.0f);
+    auto a = tensor<float>::from_vector(data, {64, 32});
+    tensor<float> b = a;
+    b.transpose({1, 0});
+    b.fill(2.0f);
+
+    const auto snap = instrument::snapshot();
+    cout << "allocations: " << snap.total.allocations << ", bytes: " << snap.total.bytes_allocated
+         << endl;
+    cout << "copies: " << snap.total.copies << ", bytes: " << snap.total.bytes_copied << endl;
+    for (const auto& op : snap.ops)
+        cout << op.first << ": calls = " << op.second.calls
+             << ", bytes allocated = " << op.second.bytes_allocated
+             << ", bytes copied = " << op.second.bytes_copied << endl;
+
+    instrument::reset();
+    cout << "after reset: " << instrument::snapshot().total.bytes_copied << endl;
+}
+
+/*
+Expected Output:
+===============
+allocations: 3, bytes: 24576
+copies: 4, bytes: 32768
+tensor::copy: calls = 1, bytes allocated = 8192, bytes copied = 8192
+tensor::fill: calls = 2, bytes allocated = 0, bytes copied = 16384
+tensor::from_vector: calls = 1, bytes allocated = 8192, bytes copied = 8192
+tensor::tensor: calls = 1, bytes allocated = 8192, bytes copied = 0
+tensor::transpose: calls = 1, bytes allocated = 8192, bytes copied = 8192
+after reset: 0
+*/
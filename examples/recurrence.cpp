@@ -0,0 +1,48 @@
+#include "shol/math/recurrence.hpp"
+#include <iostream>
+#include <vector>
+
+int main() {
+    using namespace std;
+    using namespace shol;
+
+    constexpr long long mod = 1000000007;
+    typedef Modular<long long, mod> mint;
+
+    ModMatrix<long long, mod> a = {{1, 1}, {1, 0}};
+    cout << "a:\n" << a << endl;
+    cout << "a * a:\n" << a * a << endl;
+    cout << "pow(a, 10):\n" << pow(a, 10) << endl;
+    cout << "a * (1 0): " << (a * vector<mint>{1, 0})[0] << endl;
+
+    // fibonacci, a[n] = a[n-1] + a[n-2]
+    LinearRecurrence<long long, mod> fib({1, 1}, {0, 1});
+    cout << "fib[10] = " << fib[10] << endl;
+    cout << "fib[10^18] = " << fib[1000000000000000000ULL] << " (mod " << mod << ")" << endl;
+    cout << "companion:\n" << fib.matrix() << endl;
+
+    // tribonacci through the one shot helper
+    cout << "trib[10^18] = "
+         << linear_recurrence<long long, mod>({1, 1, 1}, {0, 0, 1}, 1000000000000000000ULL) << endl;
+}
+
+/*
+Expected Output:
+===============
+a:
+[[1 1]
+ [1 0]]
+a * a:
+[[2 1]
+ [1 1]]
+pow(a, 10):
+[[89 55]
+ [55 34]]
+a * (1 0): 1
+fib[10] = 55
+fib[10^18] = 209783453 (mod 1000000007)
+companion:
+[[1 1]
+ [1 0]]
+trib[10^18] = 913728402
+*/
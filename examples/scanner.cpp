@@ -0,0 +1,52 @@
+#include "shol/io/printer.hpp"
+#include "shol/io/scanner.hpp"
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+int main() {
+    using namespace std;
+    using namespace shol;
+
+    // text as written by the printer, a file path or descriptor works the same way
+    const string text = "(1, 2.5, test)\n"
+                        "{(one, 1), (two, 2)}\n"
+                        "{{1, 2}, {3, 4}}\n"
+                        "{1, 0, 1}\n"
+                        "[[1 2 3]\n [4 5 6]]\n"
+                        "7 8 9\n";
+    Scanner in(text.data(), text.size());
+
+    tuple<int, double, string> tpl;
+    map<string, int> dict;
+    vector<vector<int>> mat;
+    vector<bool> flags;
+    tensor<float> t({1});
+    in >> tpl >> dict >> mat >> flags >> t;
+    auto plain = in.read_vector<long long>(3);
+
+    cout << "tuple<int, double, string>: " << tpl << endl;
+    cout << "map<string,int>: " << dict << endl;
+    cout << "vector<vector<int>>: " << mat << endl;
+    cout << "vector<bool>: " << flags << endl;
+    cout << "tensor<float> " << t.get_shape() << ":\n" << t << endl;
+    cout << "read_vector<long long>(3): " << plain << endl;
+    cout << "eof: " << in.eof() << endl;
+}
+
+/*
+Expected Output:
+===============
+tuple<int, double, string>: (1, 2.5, test)
+map<string,int>: {(one, 1), (two, 2)}
+vector<vector<int>>: {{1, 2}, {3, 4}}
+vector<bool>: {1, 0, 1}
+tensor<float> (2 3):
+[[1 2 3]
+ [4 5 6]]
+read_vector<long long>(3): {7, 8, 9}
+eof: 1
+*/
@@ -1,13 +1,218 @@
 #pragma once
 
+#include "shol/utils/traits.hpp"
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <type_traits>
 #include <utility>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
 
 namespace shol {
 
+// --------------------[ mixers ]--------------------
+
+constexpr uint64_t HASH_SECRET0 = 0xa0761d6478bd642full;
+constexpr uint64_t HASH_SECRET1 = 0xe7037ed1a0b428dbull;
+
+// 64x64 -> 128 bit multiply folded back to 64 bits (wyhash's mum).
+inline uint64_t mum(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    const __uint128_t r = static_cast<__uint128_t>(a) * b;
+    return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    uint64_t hi;
+    const uint64_t lo = _umul128(a, b, &hi);
+    return lo ^ hi;
+#else
+    const uint64_t ha = a >> 32, la = a & 0xffffffffull;
+    const uint64_t hb = b >> 32, lb = b & 0xffffffffull;
+    const uint64_t hh = ha * hb, hl = ha * lb, lh = la * hb, ll = la * lb;
+    const uint64_t mid = (ll >> 32) + (hl & 0xffffffffull) + (lh & 0xffffffffull);
+    const uint64_t lo = (mid << 32) | (ll & 0xffffffffull);
+    const uint64_t hi = hh + (hl >> 32) + (lh >> 32) + (mid >> 32);
+    return lo ^ hi;
+#endif
+}
+
+// --------------------[ hash_state ]--------------------
+// Words are absorbed one at a time, so composite keys cost a multiply per element.
+
+class hash_state {
+    uint64_t state_m;
+
+public:
+    explicit hash_state(uint64_t seed = 0) noexcept : state_m(seed) {}
+
+    hash_state& combine(uint64_t word) noexcept {
+        // word joins the state before the multiply, no single word can cancel what came before
+        state_m = mum(state_m ^ word ^ HASH_SECRET0, HASH_SECRET1);
+        return *this;
+    }
+
+    uint64_t value() const noexcept { return state_m; }
+};
+
+// --------------------[ hash_append ]--------------------
+// Protocol used by Hash<>. Overload hash_append(hash_state&, const YourType&) in the type's
+// namespace to make it hashable.
+
+template <class T>
+typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+hash_append(hash_state& h, const T& val);
+
+template <class T>
+typename std::enable_if<std::is_floating_point<T>::value>::type hash_append(hash_state& h,
+                                                                            const T& val);
+
+template <class Ch, class Tr, class Alloc>
+void hash_append(hash_state& h, const std::basic_string<Ch, Tr, Alloc>& val);
+
+template <class Ch>
+typename std::enable_if<is_char<Ch>::value>::type hash_append(hash_state& h, const Ch* val);
+
+template <class T1, class T2>
+void hash_append(hash_state& h, const std::pair<T1, T2>& val);
+
+template <class... Args>
+void hash_append(hash_state& h, const std::tuple<Args...>& val);
+
+template <class T>
+typename std::enable_if<is_container<T>::value && !is_string<T>::value &&
+                        !is_unordered<T>::value>::type
+hash_append(hash_state& h, const T& container);
+
+template <class T>
+typename std::enable_if<is_unordered<T>::value>::type hash_append(hash_state& h,
+                                                                  const T& container);
+
+template <class T>
+typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+hash_append(hash_state& h, const T& val) {
+    h.combine(static_cast<uint64_t>(val));
+}
+
+template <class T>
+typename std::enable_if<std::is_floating_point<T>::value>::type hash_append(hash_state& h,
+                                                                            const T& val) {
+    // +0.0 and -0.0 compare equal so they must hash equal.
+    const double d = val == T(0) ? 0.0 : static_cast<double>(val);
+    uint64_t bits;
+    std::memcpy(&bits, &d, sizeof(bits));
+    h.combine(bits);
+}
+
+inline void hash_bytes(hash_state& h, const void* data, size_t len) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint64_t word;
+    for (size_t n = len / sizeof(word); n; n--, p += sizeof(word)) {
+        std::memcpy(&word, p, sizeof(word));
+        h.combine(word);
+    }
+    word = 0;
+    std::memcpy(&word, p, len % sizeof(word));
+    h.combine(word ^ (static_cast<uint64_t>(len) << 56));
+}
+
+// strings and C strings hash alike so either can look up the other.
+template <class Ch, class Tr, class Alloc>
+void hash_append(hash_state& h, const std::basic_string<Ch, Tr, Alloc>& val) {
+    hash_bytes(h, val.data(), val.size() * sizeof(Ch));
+}
+
+template <class Ch>
+typename std::enable_if<is_char<Ch>::value>::type hash_append(hash_state& h, const Ch* val) {
+    hash_bytes(h, val, std::char_traits<Ch>::length(val) * sizeof(Ch));
+}
+
+template <class T1, class T2>
+void hash_append(hash_state& h, const std::pair<T1, T2>& val) {
+    hash_append(h, val.first);
+    hash_append(h, val.second);
+}
+
+template <class Tuple, std::size_t... Is>
+void hash_append_tuple(hash_state& h, const Tuple& t, std::index_sequence<Is...>) {
+    using swallow = int[];
+    (void)swallow{0, (hash_append(h, std::get<Is>(t)), 0)...};
+}
+
+template <class... Args>
+void hash_append(hash_state& h, const std::tuple<Args...>& val) {
+    hash_append_tuple(h, val, std::make_index_sequence<sizeof...(Args)>());
+}
+
+template <class T>
+typename std::enable_if<is_container<T>::value && !is_string<T>::value &&
+                        !is_unordered<T>::value>::type
+hash_append(hash_state& h, const T& container) {
+    uint64_t n = 0;
+    for (const auto& x : container) {
+        hash_append(h, x);
+        n++;
+    }
+    // length terminates the sequence so {{1}, {2}} and {{1, 2}} differ.
+    h.combine(n);
+}
+
+// equal unordered containers may iterate in different orders, so elements are hashed on their
+// own and summed.
+template <class T>
+typename std::enable_if<is_unordered<T>::value>::type hash_append(hash_state& h,
+                                                                  const T& container) {
+    uint64_t sum = 0, n = 0;
+    for (const auto& x : container) {
+        hash_state e;
+        hash_append(e, x);
+        sum += e.value();
+        n++;
+    }
+    h.combine(sum);
+    h.combine(n);
+}
+
+// --------------------[ Hash ]--------------------
+// Drop-in hasher for unordered containers, well mixed in the low bits for power-of-two tables.
+// Hash<> (Hash<void>) is transparent and hashes whatever it is given.
+
+template <class T = void>
+struct Hash {
+    size_t operator()(const T& val) const {
+        hash_state h;
+        hash_append(h, val);
+        return static_cast<size_t>(h.value());
+    }
+};
+
+template <>
+struct Hash<void> {
+    typedef void is_transparent;
+
+    template <class T>
+    size_t operator()(const T& val) const {
+        hash_state h;
+        hash_append(h, val);
+        return static_cast<size_t>(h.value());
+    }
+};
+
+// --------------------[ CantorHash ]--------------------
+// Cantor pairing over zigzag encoded coordinates. Unique for |x|, |y| < 2^30 but poorly mixed,
+// prefer Hash<> for power-of-two bucket tables.
+
 struct CantorHash {
-	size_t operator()(const std::pair<int, int>& p) const {
-		return (p.first + p.second)*(p.first + p.second + 1) / 2 + p.second;
-	}
+    static uint64_t zigzag(int x) {
+        return (static_cast<uint32_t>(x) << 1) ^ (x < 0 ? 0xffffffffu : 0u);
+    }
+
+    size_t operator()(const std::pair<int, int>& p) const {
+        const uint64_t a = zigzag(p.first), b = zigzag(p.second);
+        return static_cast<size_t>((a + b) * (a + b + 1) / 2 + b);
+    }
 };
 
 } // namespace shol
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "shol/ds/FlatHashTable.hpp"
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+
+namespace shol {
+
+template <class Key, class T>
+struct FlatHashMapKey {
+    static const Key& get(const std::pair<const Key, T>& val) { return val.first; }
+};
+
+// Open addressing replacement for std::unordered_map. Elements live in one contiguous array,
+// so references are invalidated by any insert that grows the table and by erase.
+template <class Key, class T, class Hasher = Hash<Key>, class KeyEqual = std::equal_to<Key>>
+class FlatHashMap
+    : public FlatHashTable<Key, std::pair<const Key, T>, FlatHashMapKey<Key, T>, Hasher, KeyEqual> {
+    typedef FlatHashTable<Key, std::pair<const Key, T>, FlatHashMapKey<Key, T>, Hasher, KeyEqual>
+        Base;
+
+public:
+    typedef T mapped_type;
+    typedef typename Base::value_type value_type;
+    typedef typename Base::iterator iterator;
+    typedef typename Base::const_iterator const_iterator;
+
+    using Base::Base;
+
+    FlatHashMap(std::initializer_list<value_type> init, size_t bucket_count = 0,
+                const Hasher& hash = Hasher(), const KeyEqual& eq = KeyEqual())
+        : Base(bucket_count ? bucket_count : init.size(), hash, eq) {
+        this->insert(init.begin(), init.end());
+    }
+
+    template <class InputIt>
+    FlatHashMap(InputIt first, InputIt last, size_t bucket_count = 0,
+                const Hasher& hash = Hasher(), const KeyEqual& eq = KeyEqual())
+        : Base(bucket_count, hash, eq) {
+        this->insert(first, last);
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+        const auto r = this->insert_key(key, [&](value_type* slot) {
+            new (slot) value_type(std::piecewise_construct, std::forward_as_tuple(key),
+                                  std::forward_as_tuple(std::forward<Args>(args)...));
+        });
+        return {this->iterator_at(r.first), r.second};
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+        const auto r = this->insert_key(key, [&](value_type* slot) {
+            new (slot) value_type(std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+                                  std::forward_as_tuple(std::forward<Args>(args)...));
+        });
+        return {this->iterator_at(r.first), r.second};
+    }
+
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj) {
+        auto r = try_emplace(key, std::forward<M>(obj));
+        if (!r.second)
+            r.first->second = std::forward<M>(obj);
+        return r;
+    }
+
+    T& operator[](const Key& key) { return try_emplace(key).first->second; }
+    T& operator[](Key&& key) { return try_emplace(std::move(key)).first->second; }
+
+    T& at(const Key& key) {
+        auto it = this->find(key);
+        if (it == this->end())
+            throw std::out_of_range("FlatHashMap::at key not found.");
+        return it->second;
+    }
+
+    const T& at(const Key& key) const {
+        auto it = this->find(key);
+        if (it == this->end())
+            throw std::out_of_range("FlatHashMap::at key not found.");
+        return it->second;
+    }
+};
+
+} // namespace shol
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "shol/ds/FlatHashTable.hpp"
+#include <functional>
+#include <initializer_list>
+
+namespace shol {
+
+template <class Key>
+struct FlatHashSetKey {
+    static const Key& get(const Key& val) { return val; }
+};
+
+// Open addressing replacement for std::unordered_set. Iterators are invalidated by any insert
+// that grows the table and by erase.
+template <class Key, class Hasher = Hash<Key>, class KeyEqual = std::equal_to<Key>>
+class FlatHashSet : public FlatHashTable<Key, Key, FlatHashSetKey<Key>, Hasher, KeyEqual> {
+    typedef FlatHashTable<Key, Key, FlatHashSetKey<Key>, Hasher, KeyEqual> Base;
+
+public:
+    typedef typename Base::value_type value_type;
+    typedef typename Base::iterator iterator;
+    typedef typename Base::const_iterator const_iterator;
+
+    using Base::Base;
+
+    FlatHashSet(std::initializer_list<Key> init, size_t bucket_count = 0,
+                const Hasher& hash = Hasher(), const KeyEqual& eq = KeyEqual())
+        : Base(bucket_count ? bucket_count : init.size(), hash, eq) {
+        this->insert(init.begin(), init.end());
+    }
+
+    template <class InputIt>
+    FlatHashSet(InputIt first, InputIt last, size_t bucket_count = 0,
+                const Hasher& hash = Hasher(), const KeyEqual& eq = KeyEqual())
+        : Base(bucket_count, hash, eq) {
+        this->insert(first, last);
+    }
+};
+
+} // namespace shol
@@ -0,0 +1,486 @@
+#pragma once
+
+#include "shol/algo/hash.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SHOL_FLAT_HASH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace shol {
+
+// Open addressing table shared by FlatHashMap and FlatHashSet.
+//
+// One control byte per slot holds either EMPTY or the low 7 bits of the hash (h2). Lookups
+// start at the home slot (h1) and compare 16 control bytes at a time, so most misses are
+// answered by a single group load. Probing is linear, which lets erase shift the following
+// run back by one instead of leaving tombstones. The table never exceeds 7/8 load.
+
+namespace flat_hash_detail {
+
+constexpr size_t GROUP_WIDTH = 16;
+constexpr int8_t EMPTY = -128;
+
+// Bitmasks over the 16 control bytes starting at pos, bit i is set when byte i matches.
+struct Group {
+#ifdef SHOL_FLAT_HASH_SSE2
+    __m128i ctrl;
+
+    explicit Group(const int8_t* pos)
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+    uint32_t match(int8_t h2) const {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2))));
+    }
+
+    uint32_t match_empty() const { return static_cast<uint32_t>(_mm_movemask_epi8(ctrl)); }
+#else
+    const int8_t* ctrl;
+
+    explicit Group(const int8_t* pos) : ctrl(pos) {}
+
+    uint32_t match(int8_t h2) const {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < GROUP_WIDTH; i++)
+            mask |= static_cast<uint32_t>(ctrl[i] == h2) << i;
+        return mask;
+    }
+
+    uint32_t match_empty() const { return match(EMPTY); }
+#endif
+};
+
+inline size_t lowest_bit(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_ctz(mask));
+#else
+    size_t i = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+template <class H, class E, class = void>
+struct is_transparent : std::false_type {};
+
+template <class... Ts>
+struct make_void {
+    typedef void type;
+};
+
+template <class H, class E>
+struct is_transparent<
+    H, E, typename make_void<typename H::is_transparent, typename E::is_transparent>::type>
+    : std::true_type {};
+
+} // namespace flat_hash_detail
+
+template <class Key, class Value, class KeyOfValue, class Hasher, class KeyEqual>
+class FlatHashTable {
+public:
+    typedef Key key_type;
+    typedef Value value_type;
+    typedef Hasher hasher;
+    typedef KeyEqual key_equal;
+    typedef size_t size_type;
+
+    template <bool Const>
+    class basic_iterator {
+        friend class FlatHashTable;
+        // sets hand out const elements only, modifying one would change its hash
+        typedef typename std::conditional<Const || std::is_same<Key, Value>::value, const Value,
+                                          Value>::type slot_type;
+
+        const int8_t* _ctrl;
+        const int8_t* _ctrl_end;
+        slot_type* _slot;
+
+        basic_iterator(const int8_t* ctrl, const int8_t* ctrl_end, slot_type* slot)
+            : _ctrl(ctrl), _ctrl_end(ctrl_end), _slot(slot) {
+            skip_empty();
+        }
+
+        void skip_empty() {
+            while (_ctrl != _ctrl_end && *_ctrl == flat_hash_detail::EMPTY) {
+                ++_ctrl;
+                ++_slot;
+            }
+        }
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Value value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef slot_type* pointer;
+        typedef slot_type& reference;
+
+        basic_iterator() : _ctrl(nullptr), _ctrl_end(nullptr), _slot(nullptr) {}
+        template <bool C = Const, class = typename std::enable_if<C>::type>
+        basic_iterator(const basic_iterator<false>& other)
+            : _ctrl(other._ctrl), _ctrl_end(other._ctrl_end), _slot(other._slot) {}
+
+        reference operator*() const { return *_slot; }
+        pointer operator->() const { return _slot; }
+
+        basic_iterator& operator++() {
+            ++_ctrl;
+            ++_slot;
+            skip_empty();
+            return *this;
+        }
+
+        basic_iterator operator++(int) {
+            auto it = *this;
+            ++*this;
+            return it;
+        }
+
+        friend bool operator==(const basic_iterator& a, const basic_iterator& b) {
+            return a._ctrl == b._ctrl;
+        }
+        friend bool operator!=(const basic_iterator& a, const basic_iterator& b) {
+            return a._ctrl != b._ctrl;
+        }
+
+        friend class basic_iterator<true>;
+    };
+
+    typedef basic_iterator<false> iterator;
+    typedef basic_iterator<true> const_iterator;
+
+private:
+    int8_t* _ctrl;
+    Value* _slots;
+    size_t _capacity, _size;
+    Hasher _hash;
+    KeyEqual _eq;
+
+    template <class K>
+    using enable_lookup = typename std::enable_if<
+        flat_hash_detail::is_transparent<Hasher, KeyEqual>::value && !std::is_same<K, Key>::value,
+        int>::type;
+
+    static size_t growth_limit(size_t capacity) { return capacity - capacity / 8; }
+
+    static int8_t h2(size_t hash) { return static_cast<int8_t>(hash & 0x7f); }
+
+    size_t home(size_t hash) const { return (hash >> 7) & (_capacity - 1); }
+
+    // mirror the first GROUP_WIDTH - 1 bytes after the end so a group load never wraps
+    void set_ctrl(size_t i, int8_t c) {
+        _ctrl[i] = c;
+        if (i < flat_hash_detail::GROUP_WIDTH - 1)
+            _ctrl[_capacity + i] = c;
+    }
+
+    template <class K>
+    size_t find_index(const K& key) const {
+        return _size ? find_index(key, _hash(key)) : _capacity;
+    }
+
+    template <class K>
+    size_t find_index(const K& key, size_t hash) const {
+        const size_t mask = _capacity - 1;
+        const int8_t tag = h2(hash);
+        for (size_t pos = home(hash);; pos = (pos + flat_hash_detail::GROUP_WIDTH) & mask) {
+            const flat_hash_detail::Group g(_ctrl + pos);
+            for (uint32_t m = g.match(tag); m; m &= m - 1) {
+                const size_t i = (pos + flat_hash_detail::lowest_bit(m)) & mask;
+                if (_eq(KeyOfValue::get(_slots[i]), key))
+                    return i;
+            }
+            if (g.match_empty())
+                return _capacity;
+        }
+    }
+
+    // first free slot along the probe sequence of hash, table must not be full
+    size_t find_empty(size_t hash) const {
+        const size_t mask = _capacity - 1;
+        for (size_t pos = home(hash);; pos = (pos + flat_hash_detail::GROUP_WIDTH) & mask) {
+            const uint32_t m = flat_hash_detail::Group(_ctrl + pos).match_empty();
+            if (m)
+                return (pos + flat_hash_detail::lowest_bit(m)) & mask;
+        }
+    }
+
+    void allocate(size_t capacity) {
+        _capacity = capacity;
+        _ctrl = new int8_t[capacity + flat_hash_detail::GROUP_WIDTH];
+        std::memset(_ctrl, static_cast<unsigned char>(flat_hash_detail::EMPTY),
+                    capacity + flat_hash_detail::GROUP_WIDTH);
+        _slots = std::allocator<Value>().allocate(capacity);
+    }
+
+    void release() {
+        if (!_capacity)
+            return;
+        for (size_t i = 0; i < _capacity; i++)
+            if (_ctrl[i] != flat_hash_detail::EMPTY)
+                _slots[i].~Value();
+        std::allocator<Value>().deallocate(_slots, _capacity);
+        delete[] _ctrl;
+        _ctrl = nullptr;
+        _slots = nullptr;
+        _capacity = _size = 0;
+    }
+
+    void resize(size_t capacity) {
+        int8_t* old_ctrl = _ctrl;
+        Value* old_slots = _slots;
+        const size_t old_capacity = _capacity;
+        allocate(capacity);
+        for (size_t i = 0; i < old_capacity; i++) {
+            if (old_ctrl[i] == flat_hash_detail::EMPTY)
+                continue;
+            const size_t hash = _hash(KeyOfValue::get(old_slots[i]));
+            const size_t j = find_empty(hash);
+            set_ctrl(j, h2(hash));
+            new (_slots + j) Value(std::move(old_slots[i]));
+            old_slots[i].~Value();
+        }
+        if (old_capacity) {
+            std::allocator<Value>().deallocate(old_slots, old_capacity);
+            delete[] old_ctrl;
+        }
+    }
+
+    static size_t capacity_for(size_t n) {
+        size_t capacity = flat_hash_detail::GROUP_WIDTH;
+        while (growth_limit(capacity) < n)
+            capacity <<= 1;
+        return capacity;
+    }
+
+protected:
+    // index of key and whether it was inserted. A missing element is built by construct(slot)
+    // and the slot only becomes full once that returned, so a throwing constructor leaves the
+    // table unchanged.
+    template <class K, class Construct>
+    std::pair<size_t, bool> insert_key(const K& key, Construct&& construct) {
+        const size_t hash = _hash(key);
+        if (_size) {
+            const size_t i = find_index(key, hash);
+            if (i != _capacity)
+                return {i, false};
+        }
+        if (_size + 1 > growth_limit(_capacity))
+            resize(capacity_for(_size + 1));
+        const size_t j = find_empty(hash);
+        construct(_slots + j);
+        set_ctrl(j, h2(hash));
+        _size++;
+        return {j, true};
+    }
+
+    iterator iterator_at(size_t i) {
+        return iterator(_ctrl + i, _ctrl + _capacity, _slots + i);
+    }
+    const_iterator iterator_at(size_t i) const {
+        return const_iterator(_ctrl + i, _ctrl + _capacity, _slots + i);
+    }
+
+public:
+    explicit FlatHashTable(size_t bucket_count = 0, const Hasher& hash = Hasher(),
+                           const KeyEqual& eq = KeyEqual())
+        : _ctrl(nullptr), _slots(nullptr), _capacity(0), _size(0), _hash(hash), _eq(eq) {
+        if (bucket_count)
+            reserve(bucket_count);
+    }
+
+    FlatHashTable(const FlatHashTable& other)
+        : _ctrl(nullptr), _slots(nullptr), _capacity(0), _size(0), _hash(other._hash),
+          _eq(other._eq) {
+        if (!other._capacity)
+            return;
+        allocate(other._capacity);
+        for (size_t i = 0; i < _capacity; i++) {
+            if (other._ctrl[i] == flat_hash_detail::EMPTY)
+                continue;
+            new (_slots + i) Value(other._slots[i]);
+            set_ctrl(i, other._ctrl[i]);
+            _size++;
+        }
+    }
+
+    FlatHashTable(FlatHashTable&& other) noexcept
+        : _ctrl(other._ctrl), _slots(other._slots), _capacity(other._capacity),
+          _size(other._size), _hash(std::move(other._hash)), _eq(std::move(other._eq)) {
+        other._ctrl = nullptr;
+        other._slots = nullptr;
+        other._capacity = other._size = 0;
+    }
+
+    FlatHashTable& operator=(const FlatHashTable& other) {
+        if (this != &other) {
+            FlatHashTable copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    FlatHashTable& operator=(FlatHashTable&& other) noexcept {
+        FlatHashTable moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    ~FlatHashTable() { release(); }
+
+    void swap(FlatHashTable& other) noexcept {
+        using std::swap;
+        swap(_ctrl, other._ctrl);
+        swap(_slots, other._slots);
+        swap(_capacity, other._capacity);
+        swap(_size, other._size);
+        swap(_hash, other._hash);
+        swap(_eq, other._eq);
+    }
+
+    bool empty() const noexcept { return !_size; }
+    size_t size() const noexcept { return _size; }
+    size_t capacity() const noexcept { return _capacity; }
+    float load_factor() const noexcept { return _capacity ? float(_size) / _capacity : 0.0f; }
+    hasher hash_function() const { return _hash; }
+    key_equal key_eq() const { return _eq; }
+
+    void clear() noexcept {
+        for (size_t i = 0; i < _capacity; i++) {
+            if (_ctrl[i] != flat_hash_detail::EMPTY) {
+                _slots[i].~Value();
+                _ctrl[i] = flat_hash_detail::EMPTY;
+            }
+        }
+        if (_capacity)
+            std::memset(_ctrl + _capacity, static_cast<unsigned char>(flat_hash_detail::EMPTY),
+                        flat_hash_detail::GROUP_WIDTH);
+        _size = 0;
+    }
+
+    // make room for n elements without further rehashing
+    void reserve(size_t n) {
+        if (n > growth_limit(_capacity) || !_capacity)
+            resize(capacity_for(std::max(n, _size)));
+    }
+
+    std::pair<iterator, bool> insert(const Value& val) {
+        const auto r =
+            insert_key(KeyOfValue::get(val), [&](Value* slot) { new (slot) Value(val); });
+        return {iterator_at(r.first), r.second};
+    }
+
+    std::pair<iterator, bool> insert(Value&& val) {
+        const auto r = insert_key(KeyOfValue::get(val),
+                                  [&](Value* slot) { new (slot) Value(std::move(val)); });
+        return {iterator_at(r.first), r.second};
+    }
+
+    template <class InputIt>
+    void insert(InputIt first, InputIt last) {
+        for (; first != last; ++first)
+            insert(*first);
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        return insert(Value(std::forward<Args>(args)...));
+    }
+
+    iterator find(const Key& key) { return iterator_at(find_index(key)); }
+    const_iterator find(const Key& key) const { return iterator_at(find_index(key)); }
+    template <class K, enable_lookup<K> = 0>
+    iterator find(const K& key) {
+        return iterator_at(find_index(key));
+    }
+    template <class K, enable_lookup<K> = 0>
+    const_iterator find(const K& key) const {
+        return iterator_at(find_index(key));
+    }
+
+    size_t count(const Key& key) const { return find_index(key) != _capacity; }
+    template <class K, enable_lookup<K> = 0>
+    size_t count(const K& key) const {
+        return find_index(key) != _capacity;
+    }
+
+    bool contains(const Key& key) const { return count(key); }
+    template <class K, enable_lookup<K> = 0>
+    bool contains(const K& key) const {
+        return count(key);
+    }
+
+    // Backward shift deletion. Invalidates iterators, later elements of the run move down a slot.
+    void erase(iterator pos) { erase_index(static_cast<size_t>(pos._ctrl - _ctrl)); }
+    void erase(const_iterator pos) { erase_index(static_cast<size_t>(pos._ctrl - _ctrl)); }
+
+    size_t erase(const Key& key) { return erase_key(key); }
+    template <class K, enable_lookup<K> = 0>
+    size_t erase(const K& key) {
+        return erase_key(key);
+    }
+
+    iterator begin() noexcept { return iterator_at(0); }
+    iterator end() noexcept { return iterator_at(_capacity); }
+    const_iterator begin() const noexcept { return iterator_at(0); }
+    const_iterator end() const noexcept { return iterator_at(_capacity); }
+    const_iterator cbegin() const noexcept { return iterator_at(0); }
+    const_iterator cend() const noexcept { return iterator_at(_capacity); }
+
+private:
+    template <class K>
+    size_t erase_key(const K& key) {
+        const size_t i = find_index(key);
+        if (i == _capacity)
+            return 0;
+        erase_index(i);
+        return 1;
+    }
+
+    void erase_index(size_t i) {
+        const size_t mask = _capacity - 1;
+        _slots[i].~Value();
+        for (size_t j = (i + 1) & mask; _ctrl[j] != flat_hash_detail::EMPTY; j = (j + 1) & mask) {
+            // j may fill the hole only if its home is not inside (i, j]
+            const size_t h = home(_hash(KeyOfValue::get(_slots[j])));
+            if (((j - h) & mask) < ((j - i) & mask))
+                continue;
+            new (_slots + i) Value(std::move(_slots[j]));
+            _slots[j].~Value();
+            set_ctrl(i, _ctrl[j]);
+            i = j;
+        }
+        set_ctrl(i, flat_hash_detail::EMPTY);
+        _size--;
+    }
+};
+
+template <class Key, class Value, class KeyOfValue, class Hasher, class KeyEqual>
+bool operator==(const FlatHashTable<Key, Value, KeyOfValue, Hasher, KeyEqual>& a,
+                const FlatHashTable<Key, Value, KeyOfValue, Hasher, KeyEqual>& b) {
+    if (a.size() != b.size())
+        return false;
+    for (const auto& x : a) {
+        auto it = b.find(KeyOfValue::get(x));
+        if (it == b.end() || !(*it == x))
+            return false;
+    }
+    return true;
+}
+
+template <class Key, class Value, class KeyOfValue, class Hasher, class KeyEqual>
+bool operator!=(const FlatHashTable<Key, Value, KeyOfValue, Hasher, KeyEqual>& a,
+                const FlatHashTable<Key, Value, KeyOfValue, Hasher, KeyEqual>& b) {
+    return !(a == b);
+}
+
+} // namespace shol
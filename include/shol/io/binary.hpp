@@ -0,0 +1,427 @@
+#pragma once
+
+#include "shol/io/mapped_file.hpp"
+#include "shol/math/tensor.hpp"
+#include "shol/utils/traits.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace shol {
+
+// Compact binary snapshots of the same types the printer handles.
+//
+//   arithmetic, enum  : raw bytes
+//   pair, tuple       : elements in order
+//   container, string : uint64 count, then elements
+//   tensor            : shape as a container, then data as a container
+//
+// Containers of trivially copyable elements stored contiguously (vector, string, array, tensor
+// data) are written and read as one block, padded to the element's alignment so a reader over
+// a mapped file can hand out views without copying. Values are stored in native byte order.
+
+constexpr size_t BINARY_BUFFER_SIZE = 1 << 16;
+
+// --------------------[ traits ]--------------------
+
+template <typename T>
+struct is_contiguous : std::false_type {};
+
+template <typename T, typename Alloc>
+struct is_contiguous<std::vector<T, Alloc>>
+    : std::integral_constant<bool, !std::is_same<T, bool>::value> {};
+
+template <typename Ch, typename Tr, typename Alloc>
+struct is_contiguous<std::basic_string<Ch, Tr, Alloc>> : std::true_type {};
+
+template <typename T, size_t N>
+struct is_contiguous<std::array<T, N>> : std::true_type {};
+
+// containers whose elements can be moved with a single memcpy
+template <typename C, bool = is_contiguous<C>::value>
+struct is_block : std::false_type {};
+
+template <typename C>
+struct is_block<C, true> : std::is_trivially_copyable<typename C::value_type> {};
+
+// Read only view into a reader's buffer, valid as long as the buffer is.
+template <typename T>
+class ArrayView {
+    const T* _data;
+    size_t _size;
+
+public:
+    typedef T value_type;
+    typedef const T* const_iterator;
+
+    ArrayView() : _data(nullptr), _size(0) {}
+    ArrayView(const T* data, size_t size) : _data(data), _size(size) {}
+
+    const T* data() const noexcept { return _data; }
+    size_t size() const noexcept { return _size; }
+    bool empty() const noexcept { return !_size; }
+    const T& operator[](size_t i) const { return _data[i]; }
+    const_iterator begin() const noexcept { return _data; }
+    const_iterator end() const noexcept { return _data + _size; }
+};
+
+// --------------------[ writer ]--------------------
+
+// The stream should be opened in binary mode.
+class BinaryWriter {
+    std::ostream& _os;
+    std::vector<char> _buffer;
+    uint64_t _offset;
+
+    void put(const void* data, size_t n);
+    void align(size_t alignment);
+
+    template <typename T>
+    void write_block(const T* data, uint64_t n);
+
+    template <typename Tuple, std::size_t... Is>
+    void write_tuple(const Tuple& t, std::index_sequence<Is...>);
+
+public:
+    explicit BinaryWriter(std::ostream& os);
+    BinaryWriter(const BinaryWriter&) = delete;
+    BinaryWriter& operator=(const BinaryWriter&) = delete;
+    ~BinaryWriter();
+
+    // hands buffered bytes to the stream
+    void flush();
+    // bytes written so far
+    uint64_t offset() const noexcept { return _offset; }
+
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type
+    write(const T& val);
+
+    template <typename T1, typename T2>
+    void write(const std::pair<T1, T2>& val);
+
+    template <typename... Args>
+    void write(const std::tuple<Args...>& val);
+
+    template <typename C>
+    typename std::enable_if<is_container<C>::value && is_block<C>::value>::type
+    write(const C& val);
+
+    template <typename C>
+    typename std::enable_if<is_container<C>::value && !is_block<C>::value>::type
+    write(const C& val);
+
+    template <typename T>
+    void write(const tensor<T>& val);
+};
+
+template <typename T>
+BinaryWriter& operator<<(BinaryWriter& out, const T& val) {
+    out.write(val);
+    return out;
+}
+
+// --------------------[ reader ]--------------------
+
+class BinaryReader {
+    MappedFile _map;
+    std::vector<char> _buffer;
+    const char* _begin;
+    const char* _cur;
+    const char* _end;
+
+    void get(void* data, size_t n);
+    const char* take(size_t n);
+    void align(size_t alignment);
+    [[noreturn]] void fail(const std::string& what) const;
+
+    template <typename Tuple, std::size_t... Is>
+    void read_tuple(Tuple& t, std::index_sequence<Is...>);
+
+    template <typename T>
+    void read_block(T* data, uint64_t n);
+
+public:
+    // memory maps the file, or reads it whole where that isn't possible
+    explicit BinaryReader(const std::string& path);
+    // reads from a caller owned buffer, views point into it
+    BinaryReader(const char* data, size_t size);
+    BinaryReader(const BinaryReader&) = delete;
+    BinaryReader& operator=(const BinaryReader&) = delete;
+
+    bool eof() const noexcept { return _cur == _end; }
+
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type
+    read(T& val);
+
+    template <typename T1, typename T2>
+    void read(std::pair<T1, T2>& val);
+
+    template <typename... Args>
+    void read(std::tuple<Args...>& val);
+
+    template <typename T, size_t N>
+    void read(std::array<T, N>& val);
+
+    template <typename C>
+    typename std::enable_if<is_container<C>::value && is_block<C>::value>::type read(C& val);
+
+    template <typename C>
+    typename std::enable_if<is_container<C>::value && !is_block<C>::value>::type read(C& val);
+
+    template <typename T>
+    void read(tensor<T>& val);
+
+    template <typename T>
+    T read() {
+        T val;
+        read(val);
+        return val;
+    }
+
+    // Zero copy read of a block written from vector<T>, array<T, N> or a string.
+    template <typename T>
+    ArrayView<T> read_view();
+};
+
+template <typename T>
+BinaryReader& operator>>(BinaryReader& in, T& val) {
+    in.read(val);
+    return in;
+}
+
+// -------------------------------------------------------------------------------
+
+inline BinaryWriter::BinaryWriter(std::ostream& os) : _os(os), _offset(0) {
+    _buffer.reserve(BINARY_BUFFER_SIZE);
+}
+
+inline BinaryWriter::~BinaryWriter() { flush(); }
+
+inline void BinaryWriter::flush() {
+    if (!_buffer.empty())
+        _os.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+    _buffer.clear();
+}
+
+inline void BinaryWriter::put(const void* data, size_t n) {
+    const char* p = static_cast<const char*>(data);
+    if (_buffer.size() + n > BINARY_BUFFER_SIZE) {
+        flush();
+        // large blocks skip the buffer
+        if (n >= BINARY_BUFFER_SIZE) {
+            _os.write(p, static_cast<std::streamsize>(n));
+            _offset += n;
+            return;
+        }
+    }
+    _buffer.insert(_buffer.end(), p, p + n);
+    _offset += n;
+}
+
+inline void BinaryWriter::align(size_t alignment) {
+    static const char zeros[alignof(std::max_align_t)] = {};
+    size_t pad = static_cast<size_t>((alignment - _offset % alignment) % alignment);
+    // over-aligned types can need more padding than one zeros block
+    while (pad) {
+        const size_t n = pad < sizeof(zeros) ? pad : sizeof(zeros);
+        put(zeros, n);
+        pad -= n;
+    }
+}
+
+template <typename T>
+void BinaryWriter::write_block(const T* data, uint64_t n) {
+    put(&n, sizeof(n));
+    align(alignof(T));
+    put(data, static_cast<size_t>(n * sizeof(T)));
+}
+
+template <typename T>
+typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type
+BinaryWriter::write(const T& val) {
+    put(&val, sizeof(T));
+}
+
+template <typename T1, typename T2>
+void BinaryWriter::write(const std::pair<T1, T2>& val) {
+    write(val.first);
+    write(val.second);
+}
+
+template <typename Tuple, std::size_t... Is>
+void BinaryWriter::write_tuple(const Tuple& t, std::index_sequence<Is...>) {
+    using swallow = int[];
+    (void)swallow{0, (write(std::get<Is>(t)), 0)...};
+}
+
+template <typename... Args>
+void BinaryWriter::write(const std::tuple<Args...>& val) {
+    write_tuple(val, std::make_index_sequence<sizeof...(Args)>());
+}
+
+template <typename C>
+typename std::enable_if<is_container<C>::value && is_block<C>::value>::type
+BinaryWriter::write(const C& val) {
+    write_block(val.data(), val.size());
+}
+
+template <typename C>
+typename std::enable_if<is_container<C>::value && !is_block<C>::value>::type
+BinaryWriter::write(const C& val) {
+    uint64_t n = 0;
+    for (auto it = std::begin(val); it != std::end(val); ++it)
+        n++;
+    write(n);
+    for (const auto& x : val)
+        write(x);
+}
+
+template <typename T>
+void BinaryWriter::write(const tensor<T>& val) {
+    write(val.get_shape());
+    write_block(&*val.begin(), val.size());
+}
+
+// -------------------------------------------------------------------------------
+
+inline BinaryReader::BinaryReader(const std::string& path) {
+    const int fd = open_read(path);
+    _map = MappedFile(fd);
+    if (!_map) {
+        char chunk[BINARY_BUFFER_SIZE];
+        long n;
+        while ((n = read_fd(fd, chunk, sizeof(chunk))) > 0)
+            _buffer.insert(_buffer.end(), chunk, chunk + n);
+    }
+    close_fd(fd);
+    _begin = _cur = _map ? _map.data() : _buffer.data();
+    _end = _begin + (_map ? _map.size() : _buffer.size());
+}
+
+inline BinaryReader::BinaryReader(const char* data, size_t size)
+    : _begin(data), _cur(data), _end(data + size) {}
+
+inline void BinaryReader::fail(const std::string& what) const {
+    throw std::runtime_error("BinaryReader: " + what);
+}
+
+inline const char* BinaryReader::take(size_t n) {
+    if (static_cast<size_t>(_end - _cur) < n)
+        fail("unexpected end of input.");
+    const char* p = _cur;
+    _cur += n;
+    return p;
+}
+
+inline void BinaryReader::get(void* data, size_t n) { std::memcpy(data, take(n), n); }
+
+// padding is relative to the start of the data, as on the writer side
+inline void BinaryReader::align(size_t alignment) {
+    const size_t offset = static_cast<size_t>(_cur - _begin);
+    take((alignment - offset % alignment) % alignment);
+}
+
+template <typename T>
+typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type
+BinaryReader::read(T& val) {
+    get(&val, sizeof(T));
+}
+
+template <typename T1, typename T2>
+void BinaryReader::read(std::pair<T1, T2>& val) {
+    read(val.first);
+    read(val.second);
+}
+
+template <typename Tuple, std::size_t... Is>
+void BinaryReader::read_tuple(Tuple& t, std::index_sequence<Is...>) {
+    using swallow = int[];
+    (void)swallow{0, (read(std::get<Is>(t)), 0)...};
+}
+
+template <typename... Args>
+void BinaryReader::read(std::tuple<Args...>& val) {
+    read_tuple(val, std::make_index_sequence<sizeof...(Args)>());
+}
+
+template <typename T>
+void BinaryReader::read_block(T* data, uint64_t n) {
+    align(alignof(T));
+    if (n > static_cast<uint64_t>(_end - _cur) / sizeof(T))
+        fail("block of " + std::to_string(n) + " elements runs past the end of input.");
+    if (n)
+        get(data, static_cast<size_t>(n * sizeof(T)));
+}
+
+template <typename T, size_t N>
+void BinaryReader::read(std::array<T, N>& val) {
+    const auto n = read<uint64_t>();
+    if (n != N)
+        fail("array of size " + std::to_string(N) + " can't hold " + std::to_string(n) +
+             " elements.");
+    if (std::is_trivially_copyable<T>::value) {
+        read_block(val.data(), n);
+    } else {
+        for (auto& x : val)
+            read(x);
+    }
+}
+
+template <typename C>
+typename std::enable_if<is_container<C>::value && is_block<C>::value>::type
+BinaryReader::read(C& val) {
+    const auto n = read<uint64_t>();
+    if (n > static_cast<uint64_t>(_end - _cur) / sizeof(typename C::value_type))
+        fail("block of " + std::to_string(n) + " elements runs past the end of input.");
+    val.resize(static_cast<size_t>(n));
+    read_block(n ? &val[0] : nullptr, n);
+}
+
+template <typename C>
+typename std::enable_if<is_container<C>::value && !is_block<C>::value>::type
+BinaryReader::read(C& val) {
+    const auto n = read<uint64_t>();
+    val.clear();
+    for (uint64_t i = 0; i < n; i++) {
+        typename mutable_value<typename C::value_type>::type x;
+        read(x);
+        append(val, std::move(x));
+    }
+}
+
+template <typename T>
+void BinaryReader::read(tensor<T>& val) {
+    const auto dim = read<shape>();
+    std::vector<T> data;
+    read(data);
+    if (data.size() != get_size(dim) || data.empty())
+        fail("tensor data doesn't match its shape.");
+    val = tensor<T>::from_vector(std::move(data), dim);
+}
+
+template <typename T>
+ArrayView<T> BinaryReader::read_view() {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only trivially copyable elements can be viewed in place.");
+    const auto n = read<uint64_t>();
+    align(alignof(T));
+    if (reinterpret_cast<uintptr_t>(_cur) % alignof(T))
+        fail("buffer is not aligned for a view, use read() to copy instead.");
+    if (n > static_cast<uint64_t>(_end - _cur) / sizeof(T))
+        fail("block of " + std::to_string(n) + " elements runs past the end of input.");
+    const T* data = reinterpret_cast<const T*>(_cur);
+    _cur += n * sizeof(T);
+    return ArrayView<T>(data, static_cast<size_t>(n));
+}
+
+} // namespace shol
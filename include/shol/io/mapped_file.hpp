@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace shol {
+
+inline int open_read(const std::string& path) {
+#ifdef _WIN32
+    const int fd = _open(path.c_str(), _O_RDONLY | _O_BINARY);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+#endif
+    if (fd < 0)
+        throw std::runtime_error("Can't open file '" + path + "'.");
+    return fd;
+}
+
+inline void close_fd(int fd) {
+#ifdef _WIN32
+    _close(fd);
+#else
+    ::close(fd);
+#endif
+}
+
+// bytes read, 0 at end of file and negative on error
+inline long read_fd(int fd, char* buf, size_t n) {
+#ifdef _WIN32
+    return _read(fd, buf, static_cast<unsigned>(n));
+#else
+    return static_cast<long>(::read(fd, buf, n));
+#endif
+}
+
+// Read only mapping of a whole regular file, the descriptor can be closed once mapped.
+// Stays empty when the descriptor is not mappable (pipes, empty files, Windows), callers then
+// fall back to read().
+class MappedFile {
+    void* _map;
+    size_t _size;
+
+public:
+    MappedFile() noexcept : _map(nullptr), _size(0) {}
+
+    explicit MappedFile(int fd) : _map(nullptr), _size(0) {
+#ifndef _WIN32
+        struct stat st;
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0)
+            return;
+        const size_t size = static_cast<size_t>(st.st_size);
+        void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED)
+            return;
+        madvise(map, size, MADV_SEQUENTIAL);
+        _map = map;
+        _size = size;
+#else
+        (void)fd;
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept : _map(other._map), _size(other._size) {
+        other._map = nullptr;
+        other._size = 0;
+    }
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        std::swap(_map, other._map);
+        std::swap(_size, other._size);
+        return *this;
+    }
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (_map)
+            munmap(_map, _size);
+#endif
+    }
+
+    explicit operator bool() const noexcept { return _map != nullptr; }
+    const char* data() const noexcept { return static_cast<const char*>(_map); }
+    size_t size() const noexcept { return _size; }
+};
+
+} // namespace shol
@@ -1,10 +1,16 @@
 #pragma once
 
+#include "shol/utils/traits.hpp"
 #include <ostream>
 #include <tuple>
 
 namespace shol {
 
+// declared up front so pairs and tuples can hold containers
+template <class Ch, class Tr, class T>
+typename std::enable_if<is_container<T>::value, std::basic_ostream<Ch, Tr>&>::type
+operator<<(std::basic_ostream<Ch, Tr>& os, const T& container);
+
 // --------------------[ pair ]--------------------
 template <class Ch, class Tr, class T1, class T2>
 decltype(auto) operator<<(std::basic_ostream<Ch, Tr>& os, const std::pair<T1, T2>& val) {
@@ -26,62 +32,6 @@ decltype(auto) operator<<(std::basic_ostream<Ch, Tr>& os, std::tuple<Args...> co
 }
 
 // --------------------[ container ]--------------------
-// credits for is_container<> (https://gist.github.com/louisdx/1076849)
-
-template <typename T>
-struct has_const_iterator {
-private:
-    typedef char one;
-    typedef struct {
-        char array[2];
-    } two;
-
-    template <typename C>
-    static one test(typename C::const_iterator*);
-    template <typename C>
-    static two test(...);
-
-public:
-    static const bool value = sizeof(test<T>(0)) == sizeof(one);
-    typedef T type;
-};
-
-template <typename T>
-struct has_begin_end {
-    struct Dummy {
-        typedef void const_iterator;
-    };
-    typedef typename std::conditional<has_const_iterator<T>::value, T, Dummy>::type TType;
-    typedef typename TType::const_iterator iter;
-
-    struct Fallback {
-        iter begin() const;
-        iter end() const;
-    };
-    struct Derived : TType, Fallback {};
-
-    template <typename C, C>
-    struct ChT;
-
-    template <typename C>
-    static char (&f(ChT<iter (Fallback::*)() const, &C::begin>*))[1];
-    template <typename C>
-    static char (&f(...))[2];
-    template <typename C>
-    static char (&g(ChT<iter (Fallback::*)() const, &C::end>*))[1];
-    template <typename C>
-    static char (&g(...))[2];
-
-    static bool const beg_value = sizeof(f<Derived>(0)) == 2;
-    static bool const end_value = sizeof(g<Derived>(0)) == 2;
-};
-
-template <typename T>
-struct is_container {
-    static const bool value =
-        has_const_iterator<T>::value && has_begin_end<T>::beg_value && has_begin_end<T>::end_value;
-};
-
 template <class Ch, class Tr, class T>
 typename std::enable_if<is_container<T>::value, std::basic_ostream<Ch, Tr>&>::type
 operator<<(std::basic_ostream<Ch, Tr>& os, const T& container) {
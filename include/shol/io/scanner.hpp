@@ -0,0 +1,516 @@
+#pragma once
+
+#include "shol/io/mapped_file.hpp"
+#include "shol/math/tensor.hpp"
+#include "shol/utils/traits.hpp"
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace shol {
+
+constexpr size_t SCANNER_BUFFER_SIZE = 1 << 20;
+// longest number token guaranteed to be parsed in one piece when streaming
+constexpr size_t SCANNER_MAX_TOKEN = 128;
+static_assert(SCANNER_BUFFER_SIZE > SCANNER_MAX_TOKEN * 2,
+              "Scanner buffer should hold at least two full tokens.");
+
+// Reads the text written by printer.hpp (and tensor's operator<<) back into values.
+//
+//   pair, tuple : (a, b, c)
+//   container   : {a, b, c}
+//   tensor      : [[1 2] [3 4]]
+//
+// Strings are read up to whitespace or one of ",)}]" since the printer doesn't quote them.
+// Files are memory mapped where possible, otherwise read through a large buffer.
+class Scanner {
+    const char* _cur;
+    const char* _end;
+    std::vector<char> _buffer;
+    int _fd;
+    bool _own_fd;
+    MappedFile _map;
+
+    bool refill();
+    void ensure(size_t n);
+    void skip_space();
+    char peek();
+    void expect(char c);
+    bool consume(char c);
+    void init_fd(int fd, bool own);
+    [[noreturn]] void fail(const std::string& what) const;
+
+    template <typename T>
+    T parse_float();
+
+    template <typename Tuple, std::size_t... Is>
+    void read_tuple(Tuple& t, std::index_sequence<Is...>);
+
+    template <typename T>
+    void read_tensor_level(std::vector<T>& data, shape& dim, size_t level);
+
+public:
+    explicit Scanner(const std::string& path);
+    explicit Scanner(int fd);
+    Scanner(const char* data, size_t size);
+    Scanner(const Scanner&) = delete;
+    Scanner& operator=(const Scanner&) = delete;
+    ~Scanner();
+
+    // skips whitespace, true when nothing is left to read
+    bool eof();
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && !is_char<T>::value &&
+                            !std::is_same<T, bool>::value>::type read(T& val);
+
+    void read(bool& val);
+
+    template <typename T>
+    typename std::enable_if<is_char<T>::value>::type read(T& val);
+
+    template <typename T>
+    typename std::enable_if<std::is_floating_point<T>::value>::type read(T& val);
+
+    void read(std::string& val);
+
+    template <typename T1, typename T2>
+    void read(std::pair<T1, T2>& val);
+
+    template <typename... Args>
+    void read(std::tuple<Args...>& val);
+
+    template <typename C>
+    typename std::enable_if<is_container<C>::value && !is_string<C>::value>::type read(C& val);
+
+    template <typename T, size_t N>
+    void read(std::array<T, N>& val);
+
+    template <typename T>
+    void read(tensor<T>& val);
+
+    template <typename T>
+    T read() {
+        T val;
+        read(val);
+        return val;
+    }
+
+    // n whitespace separated values, the plain layout of large numeric dumps
+    template <typename T>
+    std::vector<T> read_vector(size_t n) {
+        std::vector<T> data(n);
+        for (auto& x : data)
+            read(x);
+        return data;
+    }
+};
+
+template <typename T>
+Scanner& operator>>(Scanner& in, T& val) {
+    in.read(val);
+    return in;
+}
+
+// -------------------------------------------------------------------------------
+
+inline Scanner::Scanner(const std::string& path)
+    : _cur(nullptr), _end(nullptr), _fd(-1), _own_fd(false) {
+    const int fd = open_read(path);
+    _map = MappedFile(fd);
+    if (_map) {
+        close_fd(fd);
+        _cur = _map.data();
+        _end = _cur + _map.size();
+        return;
+    }
+    init_fd(fd, true);
+}
+
+inline Scanner::Scanner(int fd) : _cur(nullptr), _end(nullptr), _fd(-1), _own_fd(false) {
+    init_fd(fd, false);
+}
+
+inline Scanner::Scanner(const char* data, size_t size)
+    : _cur(data), _end(data + size), _fd(-1), _own_fd(false) {}
+
+inline Scanner::~Scanner() {
+    if (_own_fd)
+        close_fd(_fd);
+}
+
+inline void Scanner::init_fd(int fd, bool own) {
+    _fd = fd;
+    _own_fd = own;
+    _buffer.resize(SCANNER_BUFFER_SIZE);
+    _cur = _end = _buffer.data();
+}
+
+inline void Scanner::fail(const std::string& what) const {
+    throw std::runtime_error("Scanner: " + what);
+}
+
+// moves the unread tail to the front and tops the buffer up, false when no new bytes arrived
+inline bool Scanner::refill() {
+    if (_fd < 0)
+        return false;
+    const size_t left = static_cast<size_t>(_end - _cur);
+    std::memmove(_buffer.data(), _cur, left);
+    size_t filled = left;
+    while (filled < _buffer.size()) {
+        const long n = read_fd(_fd, _buffer.data() + filled, _buffer.size() - filled);
+        if (n <= 0)
+            break;
+        filled += static_cast<size_t>(n);
+        // don't block a pipe waiting for a full buffer
+        if (filled >= SCANNER_MAX_TOKEN)
+            break;
+    }
+    _cur = _buffer.data();
+    _end = _cur + filled;
+    return filled != left;
+}
+
+inline void Scanner::ensure(size_t n) {
+    if (static_cast<size_t>(_end - _cur) < n)
+        refill();
+}
+
+inline void Scanner::skip_space() {
+    for (;;) {
+        while (_cur != _end && static_cast<unsigned char>(*_cur) <= ' ')
+            ++_cur;
+        if (_cur != _end || !refill())
+            return;
+    }
+}
+
+inline char Scanner::peek() {
+    skip_space();
+    return _cur == _end ? '\0' : *_cur;
+}
+
+inline bool Scanner::consume(char c) {
+    if (peek() != c)
+        return false;
+    ++_cur;
+    return true;
+}
+
+inline void Scanner::expect(char c) {
+    if (!consume(c))
+        fail(std::string("expected '") + c + "' but found " +
+             (_cur == _end ? std::string("end of input") : "'" + std::string(1, *_cur) + "'") +
+             ".");
+}
+
+inline bool Scanner::eof() { return peek() == '\0' && _cur == _end; }
+
+// --------------------[ numbers ]--------------------
+
+namespace scanner_detail {
+
+inline bool is_digit(char c) { return static_cast<unsigned char>(c - '0') <= 9; }
+
+inline bool little_endian() {
+    const uint16_t probe = 1;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+// true when all 8 bytes are ASCII digits
+inline bool eight_digits(uint64_t chunk) {
+    return ((chunk & 0xF0F0F0F0F0F0F0F0ull) |
+            (((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) ==
+           0x3333333333333333ull;
+}
+
+// value of 8 ASCII digits loaded little endian, 3 multiplies instead of 8 dependent steps
+inline uint64_t parse_eight_digits(uint64_t chunk) {
+    chunk = (chunk & 0x0F0F0F0F0F0F0F0Full) * 2561 >> 8;
+    chunk = (chunk & 0x00FF00FF00FF00FFull) * 6553601 >> 16;
+    return (chunk & 0x0000FFFF0000FFFFull) * 42949672960001ull >> 32;
+}
+
+// accumulates decimal digits into x, returns the first non digit
+inline const char* parse_digits(const char* p, const char* end, uint64_t& x, size_t& count) {
+    static const bool swar = little_endian();
+    uint64_t chunk;
+    while (swar && end - p >= 8) {
+        std::memcpy(&chunk, p, 8);
+        if (!eight_digits(chunk))
+            break;
+        x = x * 100000000ull + parse_eight_digits(chunk);
+        p += 8;
+        count += 8;
+    }
+    for (; p != end && is_digit(*p); ++p, ++count)
+        x = x * 10 + static_cast<unsigned>(*p - '0');
+    return p;
+}
+
+} // namespace scanner_detail
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value && !is_char<T>::value &&
+                            !std::is_same<T, bool>::value>::type
+Scanner::read(T& val) {
+    skip_space();
+    ensure(SCANNER_MAX_TOKEN);
+    const char* p = _cur;
+    const bool neg = p != _end && *p == '-';
+    if (p != _end && (*p == '-' || *p == '+'))
+        ++p;
+    // leading zeros don't count towards the 19 digits that always fit
+    while (p != _end && *p == '0' && p + 1 != _end && scanner_detail::is_digit(p[1]))
+        ++p;
+    const char* first = p;
+    uint64_t x = 0;
+    size_t count = 0;
+    p = scanner_detail::parse_digits(p, _end, x, count);
+    if (!count)
+        fail("expected an integer.");
+    if (count > 19) {
+        // may have wrapped, redo digit by digit
+        x = 0;
+        for (const char* q = first; q != p; ++q) {
+            const uint64_t d = static_cast<uint64_t>(*q - '0');
+            if (x > (std::numeric_limits<uint64_t>::max() - d) / 10)
+                fail("integer '" + std::string(_cur, p) + "' out of range.");
+            x = x * 10 + d;
+        }
+    }
+
+    typedef typename std::make_unsigned<T>::type U;
+    const uint64_t max = static_cast<uint64_t>(std::numeric_limits<T>::max());
+    // the most negative value has one more than max in magnitude
+    const uint64_t limit = neg ? (std::is_signed<T>::value ? max + 1 : 0) : max;
+    if (x > limit)
+        fail("integer '" + std::string(_cur, p) + "' out of range.");
+    _cur = p;
+    val = static_cast<T>(neg ? static_cast<U>(0 - x) : static_cast<U>(x));
+}
+
+// printed as 0 or 1
+inline void Scanner::read(bool& val) {
+    skip_space();
+    ensure(2);
+    if (_cur == _end || (*_cur != '0' && *_cur != '1'))
+        fail("expected 0 or 1.");
+    val = *_cur++ == '1';
+    if (_cur != _end && scanner_detail::is_digit(*_cur))
+        fail("expected 0 or 1.");
+}
+
+template <typename T>
+typename std::enable_if<is_char<T>::value>::type Scanner::read(T& val) {
+    skip_space();
+    if (_cur == _end)
+        fail("unexpected end of input.");
+    val = static_cast<T>(*_cur++);
+}
+
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value>::type Scanner::read(T& val) {
+    skip_space();
+    ensure(SCANNER_MAX_TOKEN);
+    val = parse_float<T>();
+}
+
+// Clinger's fast path: up to 19 significant digits and |exponent| <= 22 convert exactly with a
+// single multiply or divide. Everything else (long mantissas, inf, nan) goes to strtod.
+template <typename T>
+T Scanner::parse_float() {
+    static const double powers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                    1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                    1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    const char* start = _cur;
+    const char* p = _cur;
+    const bool neg = p != _end && *p == '-';
+    if (p != _end && (*p == '-' || *p == '+'))
+        ++p;
+
+    uint64_t mantissa = 0;
+    size_t digits = 0, fraction = 0;
+    p = scanner_detail::parse_digits(p, _end, mantissa, digits);
+    if (p != _end && *p == '.') {
+        ++p;
+        p = scanner_detail::parse_digits(p, _end, mantissa, fraction);
+        digits += fraction;
+    }
+
+    long exponent = 0;
+    if (digits && p != _end && (*p == 'e' || *p == 'E')) {
+        const char* q = p + 1;
+        const bool eneg = q != _end && *q == '-';
+        if (q != _end && (*q == '-' || *q == '+'))
+            ++q;
+        uint64_t e = 0;
+        size_t edigits = 0;
+        q = scanner_detail::parse_digits(q, _end, e, edigits);
+        // e may have wrapped, any such exponent is far outside the fast path, leave it to strtod
+        if (edigits > 4)
+            e = 99999;
+        if (edigits) {
+            exponent = eneg ? -static_cast<long>(e) : static_cast<long>(e);
+            p = q;
+        }
+    }
+
+    if (!digits) {
+        // inf, nan as written by ostream
+        while (p != _end && ((*p | 0x20) >= 'a' && (*p | 0x20) <= 'z'))
+            ++p;
+        if (p == start + neg)
+            fail("expected a number.");
+    } else if (digits <= 19 && mantissa <= (uint64_t(1) << 53)) {
+        exponent -= static_cast<long>(fraction);
+        if (exponent >= -22 && exponent <= 22) {
+            double d = static_cast<double>(mantissa);
+            d = exponent < 0 ? d / powers[-exponent] : d * powers[exponent];
+            _cur = p;
+            return static_cast<T>(neg ? -d : d);
+        }
+    }
+
+    const std::string token(start, p);
+    char* stop;
+    const double d = std::strtod(token.c_str(), &stop);
+    if (stop == token.c_str())
+        fail("expected a number but found '" + token + "'.");
+    _cur = start + (stop - token.c_str());
+    return static_cast<T>(d);
+}
+
+// --------------------[ string ]--------------------
+
+inline void Scanner::read(std::string& val) {
+    skip_space();
+    val.clear();
+    for (;;) {
+        const char* p = _cur;
+        while (p != _end && static_cast<unsigned char>(*p) > ' ' && *p != ',' && *p != ')' &&
+               *p != '}' && *p != ']')
+            ++p;
+        val.append(_cur, p);
+        _cur = p;
+        if (p != _end || !refill())
+            break;
+    }
+}
+
+// --------------------[ pair ]--------------------
+
+template <typename T1, typename T2>
+void Scanner::read(std::pair<T1, T2>& val) {
+    expect('(');
+    read(val.first);
+    expect(',');
+    read(val.second);
+    expect(')');
+}
+
+// --------------------[ tuple ]--------------------
+
+template <typename Tuple, std::size_t... Is>
+void Scanner::read_tuple(Tuple& t, std::index_sequence<Is...>) {
+    using swallow = int[];
+    (void)swallow{0, (void(Is == 0 || (expect(','), true)), read(std::get<Is>(t)), 0)...};
+}
+
+template <typename... Args>
+void Scanner::read(std::tuple<Args...>& val) {
+    expect('(');
+    read_tuple(val, std::make_index_sequence<sizeof...(Args)>());
+    expect(')');
+}
+
+// --------------------[ container ]--------------------
+
+template <typename C>
+typename std::enable_if<is_container<C>::value && !is_string<C>::value>::type
+Scanner::read(C& val) {
+    expect('{');
+    val.clear();
+    if (consume('}'))
+        return;
+    do {
+        typename mutable_value<typename C::value_type>::type x;
+        read(x);
+        append(val, std::move(x));
+    } while (consume(','));
+    expect('}');
+}
+
+// printed like any container, but the size is fixed
+template <typename T, size_t N>
+void Scanner::read(std::array<T, N>& val) {
+    expect('{');
+    size_t n = 0;
+    if (!consume('}')) {
+        do {
+            if (n == N)
+                fail("array of size " + std::to_string(N) + " can't hold more elements.");
+            read(val[n++]);
+        } while (consume(','));
+        expect('}');
+    }
+    if (n != N)
+        fail("array of size " + std::to_string(N) + " read " + std::to_string(n) + " elements.");
+}
+
+// --------------------[ tensor ]--------------------
+
+template <typename T>
+void Scanner::read_tensor_level(std::vector<T>& data, shape& dim, size_t level) {
+    expect(PRINT_BEGIN);
+    size_t n = 0;
+    if (peek() == PRINT_BEGIN) {
+        do {
+            read_tensor_level(data, dim, level + 1);
+            n++;
+        } while (peek() == PRINT_BEGIN);
+    } else {
+        while (peek() != PRINT_END) {
+            if (peek() == '.')
+                fail("can't read a tensor printed with ellipses.");
+            T x;
+            read(x);
+            data.push_back(x);
+            n++;
+        }
+    }
+    if (peek() == '.')
+        fail("can't read a tensor printed with ellipses.");
+    expect(PRINT_END);
+
+    if (n > std::numeric_limits<shapeType>::max())
+        fail("tensor dimension too large.");
+    if (dim.size() <= level)
+        dim.resize(level + 1, 0);
+    if (dim[level] && dim[level] != n)
+        fail("ragged tensor, dimension " + std::to_string(level) + " has sizes " +
+             std::to_string(dim[level]) + " and " + std::to_string(n) + ".");
+    dim[level] = static_cast<shapeType>(n);
+}
+
+template <typename T>
+void Scanner::read(tensor<T>& val) {
+    std::vector<T> data;
+    shape dim;
+    read_tensor_level(data, dim, 0);
+    if (data.empty())
+        fail("tensor can not be empty.");
+    val = tensor<T>::from_vector(std::move(data), dim);
+}
+
+} // namespace shol
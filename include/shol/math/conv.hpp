@@ -0,0 +1,433 @@
+#pragma once
+
+#include "shol/math/tensor.hpp"
+#include "shol/utils/instrument.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SHOL_CONV_SSE2 1
+#include <emmintrin.h>
+#endif
+#ifdef _OPENMP
+#define SHOL_CONV_PARALLEL_FOR _Pragma("omp parallel for schedule(static)")
+#else
+#define SHOL_CONV_PARALLEL_FOR
+#endif
+
+namespace shol {
+
+// Convolution (cross-correlation, as in most deep learning libraries) and pooling on row major
+// tensors.
+//
+//   conv1d  input [N, C, L]    or [C, L]     weight [C_out, C, K]
+//   conv2d  input [N, C, H, W] or [C, H, W]  weight [C_out, C, KH, KW]
+//
+// Kernels with at most CONV_DIRECT_MAX_TAPS taps per channel (3x3, 5x5, 5-tap, ...) run directly:
+// every tap adds a shifted input row times a scalar into the output row, which vectorizes.
+// Larger kernels unfold the input (im2col) one tile of output rows at a time and multiply it with
+// the weights in cache sized blocks.
+// Compiled with OpenMP (-fopenmp) the direct path splits batches and output channels across
+// threads, im2col splits batches and output tiles.
+
+constexpr size_t CONV_DIRECT_MAX_TAPS = 25;
+constexpr size_t CONV_GEMM_BLOCK = 256;
+constexpr size_t CONV_GEMM_DEPTH = 128;
+
+struct conv_options {
+    size_t stride = 1;
+    size_t padding = 0;
+    size_t dilation = 1;
+};
+
+// stride 0 means stride = kernel
+struct pool_options {
+    size_t stride = 0;
+    size_t padding = 0;
+    size_t dilation = 1;
+};
+
+template <class T>
+tensor<T> conv1d(const tensor<T>& input, const tensor<T>& weight, const conv_options& opt = {},
+                 const std::vector<T>& bias = {});
+
+template <class T>
+tensor<T> conv2d(const tensor<T>& input, const tensor<T>& weight, const conv_options& opt = {},
+                 const std::vector<T>& bias = {});
+
+template <class T>
+tensor<T> max_pool1d(const tensor<T>& input, size_t kernel, const pool_options& opt = {});
+template <class T>
+tensor<T> avg_pool1d(const tensor<T>& input, size_t kernel, const pool_options& opt = {});
+template <class T>
+tensor<T> max_pool2d(const tensor<T>& input, size_t kernel, const pool_options& opt = {});
+template <class T>
+tensor<T> avg_pool2d(const tensor<T>& input, size_t kernel, const pool_options& opt = {});
+
+// -------------------------------------------------------------------------------
+
+namespace conv_detail {
+
+// sizes of a convolution or pooling seen as 2D, 1D has h = kh = 1 and no vertical padding
+struct geometry {
+    size_t n, c, h, w;
+    size_t co, kh, kw;
+    size_t sh, sw, ph, pw, dh, dw;
+    size_t ho, wo;
+};
+
+// y[i] += a * x[i]
+template <class T>
+inline void axpy(T* y, const T* x, T a, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        y[i] += a * x[i];
+}
+
+#ifdef SHOL_CONV_SSE2
+inline void axpy(float* y, const float* x, float a, size_t n) {
+    const __m128 va = _mm_set1_ps(a);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m128 y0 = _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(va, _mm_loadu_ps(x + i)));
+        const __m128 y1 =
+            _mm_add_ps(_mm_loadu_ps(y + i + 4), _mm_mul_ps(va, _mm_loadu_ps(x + i + 4)));
+        _mm_storeu_ps(y + i, y0);
+        _mm_storeu_ps(y + i + 4, y1);
+    }
+    for (; i < n; i++)
+        y[i] += a * x[i];
+}
+
+inline void axpy(double* y, const double* x, double a, size_t n) {
+    const __m128d va = _mm_set1_pd(a);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+        _mm_storeu_pd(y + i, _mm_add_pd(_mm_loadu_pd(y + i), _mm_mul_pd(va, _mm_loadu_pd(x + i))));
+    for (; i < n; i++)
+        y[i] += a * x[i];
+}
+
+inline void axpy4(float* const* y, const float* x, const float* a, size_t n) {
+    const __m128 a0 = _mm_set1_ps(a[0]), a1 = _mm_set1_ps(a[1]);
+    const __m128 a2 = _mm_set1_ps(a[2]), a3 = _mm_set1_ps(a[3]);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128 v = _mm_loadu_ps(x + i);
+        _mm_storeu_ps(y[0] + i, _mm_add_ps(_mm_loadu_ps(y[0] + i), _mm_mul_ps(a0, v)));
+        _mm_storeu_ps(y[1] + i, _mm_add_ps(_mm_loadu_ps(y[1] + i), _mm_mul_ps(a1, v)));
+        _mm_storeu_ps(y[2] + i, _mm_add_ps(_mm_loadu_ps(y[2] + i), _mm_mul_ps(a2, v)));
+        _mm_storeu_ps(y[3] + i, _mm_add_ps(_mm_loadu_ps(y[3] + i), _mm_mul_ps(a3, v)));
+    }
+    for (; i < n; i++)
+        for (size_t j = 0; j < 4; j++)
+            y[j][i] += a[j] * x[i];
+}
+#endif
+
+// y[j][i] += a[j] * x[i] for four rows, x is loaded once for all of them
+template <class T>
+inline void axpy4(T* const* y, const T* x, const T* a, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const T v = x[i];
+        y[0][i] += a[0] * v;
+        y[1][i] += a[1] * v;
+        y[2][i] += a[2] * v;
+        y[3][i] += a[3] * v;
+    }
+}
+
+// y[i] += a * x[i * stride]
+template <class T>
+inline void axpy(T* y, const T* x, T a, size_t n, size_t stride) {
+    if (stride == 1)
+        return axpy(y, x, a, n);
+    for (size_t i = 0; i < n; i++)
+        y[i] += a * x[i * stride];
+}
+
+inline size_t out_size(size_t in, size_t k, size_t stride, size_t pad, size_t dil) {
+    if (!k || !stride || !dil)
+        throw std::runtime_error("Kernel, stride and dilation must be positive.");
+    const size_t span = dil * (k - 1) + 1;
+    if (in + 2 * pad < span)
+        throw std::runtime_error("Kernel (" + std::to_string(span) + ") larger than padded input (" +
+                                 std::to_string(in + 2 * pad) + ").");
+    const size_t out = (in + 2 * pad - span) / stride + 1;
+    if (out > std::numeric_limits<shapeType>::max())
+        throw std::runtime_error("Output dimension " + std::to_string(out) + " too large.");
+    return out;
+}
+
+// outputs [lo, hi) whose input o * stride + offset falls inside [0, in)
+inline void valid_range(size_t out, size_t in, size_t stride, long offset, size_t& lo,
+                        size_t& hi) {
+    lo = offset >= 0 ? 0 : (static_cast<size_t>(-offset) + stride - 1) / stride;
+    const long last = static_cast<long>(in) - 1 - offset;
+    hi = last < 0 ? 0 : std::min(out, static_cast<size_t>(last) / stride + 1);
+    lo = std::min(lo, hi);
+}
+
+template <class T>
+void conv_direct(const T* in, const T* weight, const T* bias, T* out, const geometry& g) {
+    const long long planes = static_cast<long long>(g.n * g.co);
+SHOL_CONV_PARALLEL_FOR
+    for (long long plane = 0; plane < planes; plane++) {
+        const size_t n = static_cast<size_t>(plane) / g.co, co = static_cast<size_t>(plane) % g.co;
+        T* o = out + static_cast<size_t>(plane) * g.ho * g.wo;
+        std::fill(o, o + g.ho * g.wo, bias ? bias[co] : T(0));
+        for (size_t ci = 0; ci < g.c; ci++) {
+            const T* channel = in + (n * g.c + ci) * g.h * g.w;
+            const T* wk = weight + (co * g.c + ci) * g.kh * g.kw;
+            for (size_t ky = 0; ky < g.kh; ky++) {
+                const long offy = static_cast<long>(ky * g.dh) - static_cast<long>(g.ph);
+                size_t y0, y1;
+                valid_range(g.ho, g.h, g.sh, offy, y0, y1);
+                for (size_t kx = 0; kx < g.kw; kx++) {
+                    const long offx = static_cast<long>(kx * g.dw) - static_cast<long>(g.pw);
+                    size_t x0, x1;
+                    valid_range(g.wo, g.w, g.sw, offx, x0, x1);
+                    const T a = wk[ky * g.kw + kx];
+                    for (size_t oy = y0; oy < y1; oy++) {
+                        const T* row = channel + (oy * g.sh + offy) * g.w;
+                        axpy(o + oy * g.wo + x0, row + x0 * g.sw + offx, a, x1 - x0, g.sw);
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <class T>
+void conv_im2col(const T* in, const T* weight, const T* bias, T* out, const geometry& g) {
+    // the output is cut into tiles of whole rows holding about CONV_GEMM_BLOCK positions, each
+    // tile unfolds its own slice of the input so the unfolded block stays in cache
+    const size_t k = g.c * g.kh * g.kw, p = g.ho * g.wo;
+    const size_t tile_rows = std::max<size_t>(1, CONV_GEMM_BLOCK / g.wo);
+    const size_t tiles = (g.ho + tile_rows - 1) / tile_rows;
+SHOL_CONV_PARALLEL_FOR
+    for (long long task = 0; task < static_cast<long long>(g.n * tiles); task++) {
+        const size_t n = static_cast<size_t>(task) / tiles;
+        const size_t oy0 = static_cast<size_t>(task) % tiles * tile_rows;
+        const size_t oy1 = std::min(g.ho, oy0 + tile_rows), len = (oy1 - oy0) * g.wo;
+
+        // row (ci, ky, kx) of col holds the input seen by that tap at every position of the tile
+        std::vector<T> col(k * len);
+        for (size_t r = 0; r < k; r++) {
+            const size_t ci = r / (g.kh * g.kw), ky = r / g.kw % g.kh, kx = r % g.kw;
+            const T* channel = in + (n * g.c + ci) * g.h * g.w;
+            T* dst = col.data() + r * len;
+            const long offy = static_cast<long>(ky * g.dh) - static_cast<long>(g.ph);
+            const long offx = static_cast<long>(kx * g.dw) - static_cast<long>(g.pw);
+            size_t y0, y1, x0, x1;
+            valid_range(g.ho, g.h, g.sh, offy, y0, y1);
+            valid_range(g.wo, g.w, g.sw, offx, x0, x1);
+            for (size_t oy = oy0; oy < oy1; oy++) {
+                T* d = dst + (oy - oy0) * g.wo;
+                if (oy < y0 || oy >= y1) {
+                    std::fill(d, d + g.wo, T(0));
+                    continue;
+                }
+                const T* row = channel + (oy * g.sh + offy) * g.w + offx;
+                std::fill(d, d + x0, T(0));
+                for (size_t ox = x0; ox < x1; ox++)
+                    d[ox] = row[ox * g.sw];
+                std::fill(d + x1, d + g.wo, T(0));
+            }
+        }
+
+        // out[co, tile] = bias[co] + weight[co, :] * col. Four output channels go together so
+        // every load from col feeds four rows, and CONV_GEMM_DEPTH rows of col are reused by all
+        // channels before moving on.
+        T* o = out + n * g.co * p + oy0 * g.wo;
+        for (size_t co = 0; co < g.co; co++)
+            std::fill(o + co * p, o + co * p + len, bias ? bias[co] : T(0));
+        for (size_t r0 = 0; r0 < k; r0 += CONV_GEMM_DEPTH) {
+            const size_t r1 = std::min(k, r0 + CONV_GEMM_DEPTH);
+            for (size_t co0 = 0; co0 < g.co; co0 += 4) {
+                const size_t rows = std::min<size_t>(4, g.co - co0);
+                T* y[4];
+                const T* w[4];
+                for (size_t j = 0; j < rows; j++) {
+                    y[j] = o + (co0 + j) * p;
+                    w[j] = weight + (co0 + j) * k;
+                }
+                for (size_t r = r0; r < r1; r++) {
+                    const T* x = col.data() + r * len;
+                    if (rows == 4) {
+                        const T a[4] = {w[0][r], w[1][r], w[2][r], w[3][r]};
+                        axpy4(y, x, a, len);
+                    } else {
+                        for (size_t j = 0; j < rows; j++)
+                            axpy(y[j], x, w[j][r], len);
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <class T>
+tensor<T> conv(const tensor<T>& input, const tensor<T>& weight, const std::vector<T>& bias,
+               const conv_options& opt, size_t rank) {
+    const auto& is = input.get_shape();
+    const auto& ws = weight.get_shape();
+    const bool batched = is.size() == rank + 2;
+    if (!batched && is.size() != rank + 1)
+        throw std::runtime_error("conv" + std::to_string(rank) + "d expects an input of rank " +
+                                 std::to_string(rank + 1) + " or " + std::to_string(rank + 2) +
+                                 ", got " + std::to_string(is.size()) + ".");
+    if (ws.size() != rank + 2)
+        throw std::runtime_error("conv" + std::to_string(rank) + "d expects a weight of rank " +
+                                 std::to_string(rank + 2) + ", got " + std::to_string(ws.size()) +
+                                 ".");
+
+    geometry g;
+    const size_t b = batched ? 1 : 0;
+    g.n = batched ? is[0] : 1;
+    g.c = is[b];
+    g.h = rank == 2 ? is[b + 1] : 1;
+    g.w = is.back();
+    g.co = ws[0];
+    g.kh = rank == 2 ? ws[2] : 1;
+    g.kw = ws.back();
+    if (ws[1] != g.c)
+        throw std::runtime_error("Weight has " + std::to_string(ws[1]) + " input channels, input has " +
+                                 std::to_string(g.c) + ".");
+    if (!bias.empty() && bias.size() != g.co)
+        throw std::runtime_error("Bias size (" + std::to_string(bias.size()) +
+                                 ") != output channels (" + std::to_string(g.co) + ")");
+    g.sh = rank == 2 ? opt.stride : 1;
+    g.sw = opt.stride;
+    g.ph = rank == 2 ? opt.padding : 0;
+    g.pw = opt.padding;
+    g.dh = rank == 2 ? opt.dilation : 1;
+    g.dw = opt.dilation;
+    g.ho = out_size(g.h, g.kh, g.sh, g.ph, g.dh);
+    g.wo = out_size(g.w, g.kw, g.sw, g.pw, g.dw);
+
+    shape os;
+    if (batched)
+        os.push_back(static_cast<shapeType>(g.n));
+    os.push_back(static_cast<shapeType>(g.co));
+    if (rank == 2)
+        os.push_back(static_cast<shapeType>(g.ho));
+    os.push_back(static_cast<shapeType>(g.wo));
+    tensor<T> output(std::move(os));
+
+    const T* bp = bias.empty() ? nullptr : bias.data();
+    if (g.kh * g.kw <= CONV_DIRECT_MAX_TAPS)
+        conv_direct(&*input.begin(), &*weight.begin(), bp, &*output.begin(), g);
+    else
+        conv_im2col(&*input.begin(), &*weight.begin(), bp, &*output.begin(), g);
+    return output;
+}
+
+template <class T, bool Max>
+tensor<T> pool(const tensor<T>& input, size_t kernel, const pool_options& opt, size_t rank) {
+    const auto& is = input.get_shape();
+    if (is.size() < rank + 1)
+        throw std::runtime_error("Pooling expects an input of rank at least " +
+                                 std::to_string(rank + 1) + ", got " + std::to_string(is.size()) +
+                                 ".");
+    if (opt.padding * 2 > kernel)
+        throw std::runtime_error("Padding should be at most half the kernel size.");
+
+    // every leading dimension is a separate plane
+    geometry g;
+    g.h = rank == 2 ? is[is.size() - 2] : 1;
+    g.w = is.back();
+    g.n = input.size() / (g.h * g.w);
+    g.kh = rank == 2 ? kernel : 1;
+    g.kw = kernel;
+    const size_t stride = opt.stride ? opt.stride : kernel;
+    g.sh = rank == 2 ? stride : 1;
+    g.sw = stride;
+    g.ph = rank == 2 ? opt.padding : 0;
+    g.pw = opt.padding;
+    g.dh = rank == 2 ? opt.dilation : 1;
+    g.dw = opt.dilation;
+    g.ho = out_size(g.h, g.kh, g.sh, g.ph, g.dh);
+    g.wo = out_size(g.w, g.kw, g.sw, g.pw, g.dw);
+
+    shape os(is.begin(), is.end() - rank);
+    if (rank == 2)
+        os.push_back(static_cast<shapeType>(g.ho));
+    os.push_back(static_cast<shapeType>(g.wo));
+    tensor<T> output(std::move(os));
+
+    const T* in = &*input.begin();
+    T* out = &*output.begin();
+SHOL_CONV_PARALLEL_FOR
+    for (long long plane = 0; plane < static_cast<long long>(g.n); plane++) {
+        const T* channel = in + static_cast<size_t>(plane) * g.h * g.w;
+        T* o = out + static_cast<size_t>(plane) * g.ho * g.wo;
+        for (size_t oy = 0; oy < g.ho; oy++) {
+            for (size_t ox = 0; ox < g.wo; ox++) {
+                // padded positions are skipped, averages are over the elements actually covered
+                T acc = Max ? std::numeric_limits<T>::lowest() : T(0);
+                size_t count = 0;
+                for (size_t ky = 0; ky < g.kh; ky++) {
+                    const long iy = static_cast<long>(oy * g.sh + ky * g.dh) - static_cast<long>(g.ph);
+                    if (iy < 0 || iy >= static_cast<long>(g.h))
+                        continue;
+                    const T* row = channel + static_cast<size_t>(iy) * g.w;
+                    for (size_t kx = 0; kx < g.kw; kx++) {
+                        const long ix =
+                            static_cast<long>(ox * g.sw + kx * g.dw) - static_cast<long>(g.pw);
+                        if (ix < 0 || ix >= static_cast<long>(g.w))
+                            continue;
+                        acc = Max ? std::max(acc, row[ix]) : acc + row[ix];
+                        count++;
+                    }
+                }
+                o[oy * g.wo + ox] =
+                    Max || !count ? acc : static_cast<T>(acc / static_cast<T>(count));
+            }
+        }
+    }
+    return output;
+}
+
+} // namespace conv_detail
+
+template <class T>
+tensor<T> conv1d(const tensor<T>& input, const tensor<T>& weight, const conv_options& opt,
+                 const std::vector<T>& bias) {
+    SHOL_INSTRUMENT_SCOPE("conv1d");
+    return conv_detail::conv(input, weight, bias, opt, 1);
+}
+
+template <class T>
+tensor<T> conv2d(const tensor<T>& input, const tensor<T>& weight, const conv_options& opt,
+                 const std::vector<T>& bias) {
+    SHOL_INSTRUMENT_SCOPE("conv2d");
+    return conv_detail::conv(input, weight, bias, opt, 2);
+}
+
+template <class T>
+tensor<T> max_pool1d(const tensor<T>& input, size_t kernel, const pool_options& opt) {
+    SHOL_INSTRUMENT_SCOPE("max_pool1d");
+    return conv_detail::pool<T, true>(input, kernel, opt, 1);
+}
+
+template <class T>
+tensor<T> avg_pool1d(const tensor<T>& input, size_t kernel, const pool_options& opt) {
+    SHOL_INSTRUMENT_SCOPE("avg_pool1d");
+    return conv_detail::pool<T, false>(input, kernel, opt, 1);
+}
+
+template <class T>
+tensor<T> max_pool2d(const tensor<T>& input, size_t kernel, const pool_options& opt) {
+    SHOL_INSTRUMENT_SCOPE("max_pool2d");
+    return conv_detail::pool<T, true>(input, kernel, opt, 2);
+}
+
+template <class T>
+tensor<T> avg_pool2d(const tensor<T>& input, size_t kernel, const pool_options& opt) {
+    SHOL_INSTRUMENT_SCOPE("avg_pool2d");
+    return conv_detail::pool<T, false>(input, kernel, opt, 2);
+}
+
+} // namespace shol
@@ -0,0 +1,242 @@
+#pragma once
+
+#include "shol/math/mod.hpp"
+#include <cstdint>
+#include <initializer_list>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace shol {
+
+namespace mod_detail {
+
+#ifdef __SIZEOF_INT128__
+typedef unsigned __int128 wide;
+#else
+typedef uint64_t wide;
+#endif
+
+// Products of residues are summed in `wide` without reduction and reduced once every
+// lazy_terms(m) products. With unsigned __int128 that is once per dot product for any modulus
+// below 2^32, and at least every 4 products for moduli up to 2^63.
+constexpr uint64_t lazy_terms(uint64_t m) {
+    const wide square = wide(m - 1) * (m - 1);
+    const wide terms = (~wide(0) - (m - 1)) / square;
+    return terms > ~uint64_t(0) ? ~uint64_t(0) : static_cast<uint64_t>(terms);
+}
+
+template <uint64_t M>
+inline uint64_t mul(uint64_t a, uint64_t b) {
+    return static_cast<uint64_t>(wide(a) * b % M);
+}
+
+// sum of a[i] * b[i] mod M, all inputs already reduced
+template <uint64_t M>
+inline uint64_t dot(const uint64_t* a, const uint64_t* b, size_t n) {
+    constexpr uint64_t terms = lazy_terms(M);
+    wide acc = 0;
+    size_t i = 0;
+    while (i < n) {
+        const size_t end = n - i > terms ? i + static_cast<size_t>(terms) : n;
+        for (; i < end; i++)
+            acc += wide(a[i]) * b[i];
+        acc %= M;
+    }
+    return static_cast<uint64_t>(acc);
+}
+
+} // namespace mod_detail
+
+// Dense row major matrix over Modular<T, Modulus>.
+// Entries are kept reduced, every entry of a product is one dot product reduced once (see
+// mod_detail::lazy_terms) instead of a % per multiply-accumulate.
+template <class T, T Modulus>
+class ModMatrix {
+    static_assert(std::is_integral<T>::value, "ModMatrix needs an integral type");
+    static_assert(sizeof(mod_detail::wide) > 8 || static_cast<uint64_t>(Modulus) <= (1ULL << 32),
+                  "Moduli above 2^32 need unsigned __int128");
+    static constexpr uint64_t M = static_cast<uint64_t>(Modulus);
+
+    size_t _rows, _cols;
+    std::vector<uint64_t> _data;
+
+public:
+    typedef Modular<T, Modulus> value_type;
+
+    ModMatrix(size_t rows, size_t cols);
+    ModMatrix(std::initializer_list<std::initializer_list<T>> rows);
+    static ModMatrix identity(size_t n);
+
+    size_t rows() const noexcept;
+    size_t cols() const noexcept;
+    value_type operator()(size_t i, size_t j) const;
+    void set(size_t i, size_t j, const value_type& v);
+
+    ModMatrix& operator+=(const ModMatrix& a);
+    ModMatrix& operator*=(const ModMatrix& a);
+    bool operator==(const ModMatrix& a) const;
+    bool operator!=(const ModMatrix& a) const;
+
+    template <class T1, T1 Modulus1>
+    friend ModMatrix<T1, Modulus1> operator*(const ModMatrix<T1, Modulus1>& a,
+                                             const ModMatrix<T1, Modulus1>& b);
+
+    template <class T1, T1 Modulus1>
+    friend std::vector<Modular<T1, Modulus1>> operator*(const ModMatrix<T1, Modulus1>& a,
+                                                        const std::vector<Modular<T1, Modulus1>>& v);
+};
+
+template <class T, T Modulus>
+ModMatrix<T, Modulus>::ModMatrix(size_t rows, size_t cols)
+    : _rows(rows), _cols(cols), _data(rows * cols) {}
+
+template <class T, T Modulus>
+ModMatrix<T, Modulus>::ModMatrix(std::initializer_list<std::initializer_list<T>> rows)
+    : _rows(rows.size()), _cols(rows.size() ? rows.begin()->size() : 0) {
+    _data.reserve(_rows * _cols);
+    for (const auto& row : rows) {
+        if (row.size() != _cols)
+            throw std::runtime_error("Row size (" + std::to_string(row.size()) +
+                                     ") != column count (" + std::to_string(_cols) + ")");
+        for (const auto& x : row)
+            _data.push_back(static_cast<uint64_t>(value_type(x).Value()));
+    }
+}
+
+template <class T, T Modulus>
+ModMatrix<T, Modulus> ModMatrix<T, Modulus>::identity(size_t n) {
+    ModMatrix m(n, n);
+    for (size_t i = 0; i < n; i++)
+        m._data[i * n + i] = 1;
+    return m;
+}
+
+template <class T, T Modulus>
+size_t ModMatrix<T, Modulus>::rows() const noexcept {
+    return _rows;
+}
+
+template <class T, T Modulus>
+size_t ModMatrix<T, Modulus>::cols() const noexcept {
+    return _cols;
+}
+
+template <class T, T Modulus>
+Modular<T, Modulus> ModMatrix<T, Modulus>::operator()(size_t i, size_t j) const {
+    return value_type(static_cast<T>(_data[i * _cols + j]));
+}
+
+template <class T, T Modulus>
+void ModMatrix<T, Modulus>::set(size_t i, size_t j, const value_type& v) {
+    _data[i * _cols + j] = static_cast<uint64_t>(v.Value());
+}
+
+template <class T, T Modulus>
+ModMatrix<T, Modulus>& ModMatrix<T, Modulus>::operator+=(const ModMatrix<T, Modulus>& a) {
+    if (_rows != a._rows || _cols != a._cols)
+        throw std::runtime_error("Can't add matrices of different shapes.");
+    for (size_t i = 0; i < _data.size(); i++) {
+        _data[i] += a._data[i];
+        if (_data[i] >= M)
+            _data[i] -= M;
+    }
+    return *this;
+}
+
+template <class T, T Modulus>
+ModMatrix<T, Modulus>& ModMatrix<T, Modulus>::operator*=(const ModMatrix<T, Modulus>& a) {
+    return *this = *this * a;
+}
+
+template <class T, T Modulus>
+bool ModMatrix<T, Modulus>::operator==(const ModMatrix<T, Modulus>& a) const {
+    return _rows == a._rows && _cols == a._cols && _data == a._data;
+}
+
+template <class T, T Modulus>
+bool ModMatrix<T, Modulus>::operator!=(const ModMatrix<T, Modulus>& a) const {
+    return !(*this == a);
+}
+
+template <class T, T Modulus>
+ModMatrix<T, Modulus> operator+(const ModMatrix<T, Modulus>& a, const ModMatrix<T, Modulus>& b) {
+    ModMatrix<T, Modulus> s(a);
+    return s += b;
+}
+
+template <class T, T Modulus>
+ModMatrix<T, Modulus> operator*(const ModMatrix<T, Modulus>& a, const ModMatrix<T, Modulus>& b) {
+    constexpr uint64_t M = static_cast<uint64_t>(Modulus);
+    if (a._cols != b._rows)
+        throw std::runtime_error("Can't multiply (" + std::to_string(a._rows) + " " +
+                                 std::to_string(a._cols) + ") with (" + std::to_string(b._rows) +
+                                 " " + std::to_string(b._cols) + ")");
+
+    // columns of b made contiguous, so every entry is a dot product of two rows
+    const size_t n = a._cols;
+    std::vector<uint64_t> bt(b._data.size());
+    for (size_t i = 0; i < b._rows; i++)
+        for (size_t j = 0; j < b._cols; j++)
+            bt[j * n + i] = b._data[i * b._cols + j];
+
+    ModMatrix<T, Modulus> c(a._rows, b._cols);
+    for (size_t i = 0; i < a._rows; i++)
+        for (size_t j = 0; j < b._cols; j++)
+            c._data[i * c._cols + j] = mod_detail::dot<M>(&a._data[i * n], &bt[j * n], n);
+    return c;
+}
+
+template <class T, T Modulus>
+std::vector<Modular<T, Modulus>> operator*(const ModMatrix<T, Modulus>& a,
+                                           const std::vector<Modular<T, Modulus>>& v) {
+    constexpr uint64_t M = static_cast<uint64_t>(Modulus);
+    if (a._cols != v.size())
+        throw std::runtime_error("Can't multiply (" + std::to_string(a._rows) + " " +
+                                 std::to_string(a._cols) + ") with a vector of size " +
+                                 std::to_string(v.size()));
+    std::vector<uint64_t> x(v.size());
+    for (size_t i = 0; i < v.size(); i++)
+        x[i] = static_cast<uint64_t>(v[i].Value());
+
+    std::vector<Modular<T, Modulus>> r;
+    r.reserve(a._rows);
+    for (size_t i = 0; i < a._rows; i++)
+        r.emplace_back(static_cast<T>(mod_detail::dot<M>(&a._data[i * a._cols], x.data(), x.size())));
+    return r;
+}
+
+// binary exponentiation, O(k^3 log e) for a k x k matrix
+template <class T, T Modulus>
+ModMatrix<T, Modulus> pow(ModMatrix<T, Modulus> a, uint64_t e) {
+    if (a.rows() != a.cols())
+        throw std::runtime_error("Can't raise a non square matrix (" + std::to_string(a.rows()) +
+                                 " " + std::to_string(a.cols()) + ") to a power.");
+    auto p = ModMatrix<T, Modulus>::identity(a.rows());
+    while (e) {
+        if (e & 1)
+            p *= a;
+        e >>= 1;
+        if (e)
+            a *= a;
+    }
+    return p;
+}
+
+template <class Ch, class Tr, class T, T Modulus>
+decltype(auto) operator<<(std::basic_ostream<Ch, Tr>& os, const ModMatrix<T, Modulus>& m) {
+    os << '[';
+    for (size_t i = 0; i < m.rows(); i++) {
+        if (i)
+            os << "\n ";
+        os << '[';
+        for (size_t j = 0; j < m.cols(); j++)
+            os << (j ? " " : "") << m(i, j);
+        os << ']';
+    }
+    return os << ']';
+}
+
+} // namespace shol
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "shol/math/matrix.hpp"
+#include "shol/math/mod.hpp"
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace shol {
+
+// k-th order linear recurrence mod Modulus
+//   a[n] = c[0] a[n-1] + c[1] a[n-2] + ... + c[k-1] a[n-k]   given a[0] .. a[k-1]
+//
+// a[n] is evaluated in O(k^2 log n) with Kitamasa's method: x^n is reduced modulo the
+// characteristic polynomial P(x) = x^k - c[0] x^(k-1) - ... - c[k-1], and if
+// x^n = r[0] + r[1] x + ... + r[k-1] x^(k-1) (mod P) then a[n] = r[0] a[0] + ... + r[k-1] a[k-1].
+// Raising the k x k companion matrix to the n-th power gives the same in O(k^3 log n).
+template <class T, T Modulus>
+class LinearRecurrence {
+    static constexpr uint64_t M = static_cast<uint64_t>(Modulus);
+    typedef std::vector<uint64_t> poly;
+
+    size_t _k;
+    poly _initial;
+    // _fold[i * (k - 1) + d] = coefficient of x^i in x^(k + d) mod P, for d < k - 1
+    poly _fold;
+    // x^k mod P
+    poly _xk;
+
+    static uint64_t add(uint64_t a, uint64_t b) {
+        a += b;
+        return a >= M ? a - M : a;
+    }
+
+    // a * x mod P
+    poly times_x(const poly& a) const {
+        poly r(_k);
+        const uint64_t top = a[_k - 1];
+        r[0] = mod_detail::mul<M>(top, _xk[0]);
+        for (size_t i = 1; i < _k; i++)
+            r[i] = add(a[i - 1], mod_detail::mul<M>(top, _xk[i]));
+        return r;
+    }
+
+    // a * b mod P, every coefficient of the product and of the folded result is a lazily
+    // reduced dot product
+    poly multiply(const poly& a, const poly& b) const {
+        const size_t k = _k;
+        const poly rb(b.rbegin(), b.rend());
+        poly prod(2 * k - 1);
+        for (size_t s = 0; s < prod.size(); s++) {
+            const size_t lo = s < k ? 0 : s - k + 1, hi = s < k ? s : k - 1;
+            prod[s] = mod_detail::dot<M>(&a[lo], &rb[k - 1 - s + lo], hi - lo + 1);
+        }
+
+        poly r(k);
+        for (size_t i = 0; i < k; i++)
+            r[i] = add(prod[i], mod_detail::dot<M>(prod.data() + k, _fold.data() + i * (k - 1), k - 1));
+        return r;
+    }
+
+public:
+    typedef Modular<T, Modulus> value_type;
+
+    LinearRecurrence(const std::vector<value_type>& coefficients,
+                     const std::vector<value_type>& initial);
+
+    size_t order() const noexcept;
+    // r with x^n = r[0] + r[1] x + ... + r[k-1] x^(k-1) (mod P)
+    std::vector<value_type> power(uint64_t n) const;
+    // a[n]
+    value_type operator[](uint64_t n) const;
+    // companion matrix A, (a[n+k-1] ... a[n])^T = A^n (a[k-1] ... a[0])^T
+    ModMatrix<T, Modulus> matrix() const;
+};
+
+template <class T, T Modulus>
+LinearRecurrence<T, Modulus>::LinearRecurrence(const std::vector<value_type>& coefficients,
+                                               const std::vector<value_type>& initial)
+    : _k(coefficients.size()) {
+    if (!_k)
+        throw std::runtime_error("Recurrence needs at least one coefficient.");
+    if (initial.size() != _k)
+        throw std::runtime_error("Initial values (" + std::to_string(initial.size()) +
+                                 ") != coefficients (" + std::to_string(_k) + ")");
+
+    for (const auto& x : initial)
+        _initial.push_back(static_cast<uint64_t>(x.Value()));
+    _xk.resize(_k);
+    for (size_t i = 0; i < _k; i++)
+        _xk[i] = static_cast<uint64_t>(coefficients[_k - 1 - i].Value());
+
+    // x^(k+d) mod P for d < k - 1, stored by coefficient so folding reads rows
+    _fold.resize(_k * (_k - 1));
+    poly row = _xk;
+    for (size_t d = 0; d + 1 < _k; d++) {
+        for (size_t i = 0; i < _k; i++)
+            _fold[i * (_k - 1) + d] = row[i];
+        row = times_x(row);
+    }
+}
+
+template <class T, T Modulus>
+size_t LinearRecurrence<T, Modulus>::order() const noexcept {
+    return _k;
+}
+
+template <class T, T Modulus>
+std::vector<Modular<T, Modulus>> LinearRecurrence<T, Modulus>::power(uint64_t n) const {
+    poly r(_k);
+    if (n < _k) {
+        r[n] = 1;
+    } else {
+        // left to right over the bits of n: square, then shift by x on a set bit
+        int bit = 63;
+        while (!(n >> bit & 1))
+            bit--;
+        r[0] = 1;
+        for (; bit >= 0; bit--) {
+            r = multiply(r, r);
+            if (n >> bit & 1)
+                r = times_x(r);
+        }
+    }
+
+    std::vector<value_type> out;
+    out.reserve(_k);
+    for (const auto& x : r)
+        out.emplace_back(static_cast<T>(x));
+    return out;
+}
+
+template <class T, T Modulus>
+Modular<T, Modulus> LinearRecurrence<T, Modulus>::operator[](uint64_t n) const {
+    if (n < _k)
+        return value_type(static_cast<T>(_initial[n]));
+    const auto r = power(n);
+    poly x(_k);
+    for (size_t i = 0; i < _k; i++)
+        x[i] = static_cast<uint64_t>(r[i].Value());
+    return value_type(static_cast<T>(mod_detail::dot<M>(x.data(), _initial.data(), _k)));
+}
+
+template <class T, T Modulus>
+ModMatrix<T, Modulus> LinearRecurrence<T, Modulus>::matrix() const {
+    ModMatrix<T, Modulus> a(_k, _k);
+    for (size_t j = 0; j < _k; j++)
+        a.set(0, j, value_type(static_cast<T>(_xk[_k - 1 - j])));
+    for (size_t i = 1; i < _k; i++)
+        a.set(i, i - 1, value_type(1));
+    return a;
+}
+
+// a[n] of a[n] = c[0] a[n-1] + ... + c[k-1] a[n-k], see LinearRecurrence
+template <class T, T Modulus>
+Modular<T, Modulus> linear_recurrence(const std::vector<Modular<T, Modulus>>& coefficients,
+                                      const std::vector<Modular<T, Modulus>>& initial, uint64_t n) {
+    return LinearRecurrence<T, Modulus>(coefficients, initial)[n];
+}
+
+} // namespace shol
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "shol/utils/instrument.hpp"
 #include <vector>
 #include <algorithm>
 #include <functional>
@@ -91,35 +92,44 @@ public:
 template <class Ch, class Tr>
 std::basic_ostream<Ch, Tr>& operator<<(std::basic_ostream<Ch, Tr>&, const shape&);
 
-size_t get_size(const shape&);
+inline size_t get_size(const shape&);
 
 // -------------------------------------------------------------------------------
 
 template <class T>
 tensor<T>::tensor(const shape& dim) : dim_m(dim) {
+    SHOL_INSTRUMENT_SCOPE("tensor::tensor");
     auto n = get_size(dim_m);
     if (!n)
         throw std::runtime_error("Invalid shape. Shape can not be zero.");
     data_m.resize(n);
+    SHOL_INSTRUMENT_ALLOC(n * sizeof(T));
 }
 
 template <class T>
 tensor<T>::tensor(shape&& dim) : dim_m(std::move(dim)) {
+    SHOL_INSTRUMENT_SCOPE("tensor::tensor");
     auto n = get_size(dim_m);
     if (!n)
         throw std::runtime_error("Invalid shape. Shape can not be zero.");
     data_m.resize(n);
+    SHOL_INSTRUMENT_ALLOC(n * sizeof(T));
 }
 
 template <typename T>
-tensor<T>::tensor(const tensor<T>& other) : dim_m(other.dim_m), data_m(other.data_m) {}
+tensor<T>::tensor(const tensor<T>& other) : data_m(other.data_m), dim_m(other.dim_m) {
+    SHOL_INSTRUMENT_SCOPE("tensor::copy");
+    SHOL_INSTRUMENT_ALLOC(data_m.size() * sizeof(T));
+    SHOL_INSTRUMENT_COPY(data_m.size() * sizeof(T));
+}
 
 template <typename T>
 tensor<T>::tensor(tensor<T>&& other) noexcept
-    : dim_m(std::move(other.dim_m)), data_m(std::move(other.data_m)) {}
+    : data_m(std::move(other.data_m)), dim_m(std::move(other.dim_m)) {}
 
 template <typename T>
 tensor<T> tensor<T>::from_vector(const std::vector<T>& data, const shape& dim){
+    SHOL_INSTRUMENT_SCOPE("tensor::from_vector");
     tensor<T> t(dim);
     t.fill(data);
     return t;
@@ -127,6 +137,7 @@ tensor<T> tensor<T>::from_vector(const std::vector<T>& data, const shape& dim){
 
 template <typename T>
 tensor<T> tensor<T>::from_vector(std::vector<T>&& data, const shape& dim) {
+    SHOL_INSTRUMENT_SCOPE("tensor::from_vector(&&)");
     tensor<T> t({1});
     t.data_m = std::move(data);
     t.dim_m = dim;
@@ -135,6 +146,10 @@ tensor<T> tensor<T>::from_vector(std::vector<T>&& data, const shape& dim) {
 
 template <typename T>
 tensor<T>& tensor<T>::operator=(const tensor<T>& other) {
+    SHOL_INSTRUMENT_SCOPE("tensor::operator=");
+    if (data_m.capacity() < other.data_m.size())
+        SHOL_INSTRUMENT_ALLOC(other.data_m.size() * sizeof(T));
+    SHOL_INSTRUMENT_COPY(other.data_m.size() * sizeof(T));
     dim_m = other.dim_m;
     data_m = other.data_m;
     return *this;
@@ -206,12 +221,13 @@ void tensor<T>::expand_dims(const size_t axis) {
 template<class T>
 void permute(std::vector<T>& data, const std::vector<size_t>& permutation) {
     auto copy = data;
-    for (int i = 0; i < copy.size(); i++)
+    for (size_t i = 0; i < copy.size(); i++)
         data[i] = copy[permutation[i]];
 }
 
 template <typename T>
 void tensor<T>::transpose(const std::vector<size_t>& permutation) {
+    SHOL_INSTRUMENT_SCOPE("tensor::transpose");
     if (dim_m.size() < 2)
         return;
     if (dim_m.size() != permutation.size())
@@ -223,9 +239,11 @@ void tensor<T>::transpose(const std::vector<size_t>& permutation) {
     for (size_t i = n - 1; i; i--)
         inc[i - 1] *= inc[i] * dim_m[i];
 
-	permute(inc, permutation);
+    permute(inc, permutation);
     permute(dim_m, permutation);
 
+    SHOL_INSTRUMENT_ALLOC(data_m.size() * sizeof(T));
+    SHOL_INSTRUMENT_COPY(data_m.size() * sizeof(T));
     auto data = data_m;
     shape idx(dim_m.size(), 0);
     for (size_t i = 0, j = 0; i < data.size(); i++) {
@@ -244,11 +262,15 @@ void tensor<T>::transpose(const std::vector<size_t>& permutation) {
 
 template <typename T>
 void tensor<T>::fill(const T& val) {
+    SHOL_INSTRUMENT_SCOPE("tensor::fill");
+    SHOL_INSTRUMENT_COPY(data_m.size() * sizeof(T));
     std::fill(data_m.begin(), data_m.end(), val);
 }
 
 template <typename T>
 void tensor<T>::fill(const std::vector<T>& other) {
+    SHOL_INSTRUMENT_SCOPE("tensor::fill");
+    SHOL_INSTRUMENT_COPY(data_m.size() * sizeof(T));
     const auto n = data_m.size();
     const auto m = other.size();
     if (n <= m) {
@@ -271,6 +293,7 @@ void tensor<T>::fill(const tensor<T>& other) {
 template <typename T>
 template <typename Function>
 void tensor<T>::apply(Function generator) {
+    SHOL_INSTRUMENT_SCOPE("tensor::apply");
     for (auto& element : data_m)
         element = generator(element);
 }
@@ -382,7 +405,7 @@ void tensor<T>::print(std::basic_ostream<Ch, Tr>& os, const shapeType dim, const
                 if (j)
                     os << spaces;
                 print(os, dim + 1, i);
-                if (j != n - 1)
+                if (j + 1 != n)
                     os << '\n';
             }
         } else {
@@ -422,7 +445,7 @@ std::basic_ostream<Ch, Tr>& operator<<(std::basic_ostream<Ch, Tr>& os, const sha
     return os << ')';
 }
 
-size_t get_size(const shape& s) {
+inline size_t get_size(const shape& s) {
     size_t m = 1;
     for (const auto& x : s)
         m *= x;
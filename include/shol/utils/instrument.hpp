@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#ifdef SHOL_INSTRUMENT
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#endif
+
+// Opt-in counters for allocations, copies, call counts and time spent in library kernels.
+//
+// Define SHOL_INSTRUMENT for the whole program (every translation unit, e.g. through the
+// SHOL_INSTRUMENT cmake option) to turn the hooks on. Without it the hooks expand to nothing and
+// snapshot() stays empty.
+//
+//   SHOL_INSTRUMENT_SCOPE("tensor::transpose");   // counts the call, times the enclosing scope
+//   SHOL_INSTRUMENT_ALLOC(bytes);                  // attributed to every open scope
+//   SHOL_INSTRUMENT_COPY(bytes);
+//
+// Scopes nest, so bytes and time are inclusive: a copy made by fill() inside from_vector() shows
+// up under both.
+
+namespace shol {
+namespace instrument {
+
+struct OpStats {
+    uint64_t calls = 0;
+    uint64_t nanoseconds = 0;
+    uint64_t allocations = 0;
+    uint64_t bytes_allocated = 0;
+    uint64_t copies = 0;
+    uint64_t bytes_copied = 0;
+};
+
+struct Snapshot {
+    OpStats total;
+    std::map<std::string, OpStats> ops;
+};
+
+#ifdef SHOL_INSTRUMENT
+
+constexpr bool enabled = true;
+
+struct OpCounters {
+    std::atomic<uint64_t> calls{0}, nanoseconds{0}, allocations{0}, bytes_allocated{0},
+        copies{0}, bytes_copied{0};
+
+    OpStats load() const {
+        OpStats s;
+        s.calls = calls.load(std::memory_order_relaxed);
+        s.nanoseconds = nanoseconds.load(std::memory_order_relaxed);
+        s.allocations = allocations.load(std::memory_order_relaxed);
+        s.bytes_allocated = bytes_allocated.load(std::memory_order_relaxed);
+        s.copies = copies.load(std::memory_order_relaxed);
+        s.bytes_copied = bytes_copied.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    void clear() {
+        calls = nanoseconds = allocations = bytes_allocated = copies = bytes_copied = 0;
+    }
+};
+
+struct Registry {
+    std::mutex mutex;
+    OpCounters total;
+    std::map<std::string, std::unique_ptr<OpCounters>> ops;
+};
+
+inline Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+// counters of an op, created on first use and never moved, so call sites can cache them
+inline OpCounters& op(const char* name) {
+    auto& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    auto& c = r.ops[name];
+    if (!c)
+        c.reset(new OpCounters);
+    return *c;
+}
+
+class ScopedOp {
+    typedef std::chrono::steady_clock clock;
+
+    OpCounters& _counters;
+    ScopedOp* _parent;
+    clock::time_point _start;
+
+    static ScopedOp*& current() {
+        static thread_local ScopedOp* scope = nullptr;
+        return scope;
+    }
+
+public:
+    explicit ScopedOp(OpCounters& counters)
+        : _counters(counters), _parent(current()), _start(clock::now()) {
+        _counters.calls.fetch_add(1, std::memory_order_relaxed);
+        current() = this;
+    }
+
+    ScopedOp(const ScopedOp&) = delete;
+    ScopedOp& operator=(const ScopedOp&) = delete;
+
+    ~ScopedOp() {
+        const auto ns =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - _start).count();
+        _counters.nanoseconds.fetch_add(static_cast<uint64_t>(ns), std::memory_order_relaxed);
+        current() = _parent;
+    }
+
+    static void allocated(uint64_t bytes) {
+        registry().total.allocations.fetch_add(1, std::memory_order_relaxed);
+        registry().total.bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+        for (auto* s = current(); s; s = s->_parent) {
+            s->_counters.allocations.fetch_add(1, std::memory_order_relaxed);
+            s->_counters.bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+        }
+    }
+
+    static void copied(uint64_t bytes) {
+        registry().total.copies.fetch_add(1, std::memory_order_relaxed);
+        registry().total.bytes_copied.fetch_add(bytes, std::memory_order_relaxed);
+        for (auto* s = current(); s; s = s->_parent) {
+            s->_counters.copies.fetch_add(1, std::memory_order_relaxed);
+            s->_counters.bytes_copied.fetch_add(bytes, std::memory_order_relaxed);
+        }
+    }
+};
+
+inline Snapshot snapshot() {
+    auto& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    Snapshot s;
+    s.total = r.total.load();
+    for (const auto& op : r.ops)
+        s.ops[op.first] = op.second->load();
+    return s;
+}
+
+// zeroes every counter, ops stay registered
+inline void reset() {
+    auto& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.total.clear();
+    for (auto& op : r.ops)
+        op.second->clear();
+}
+
+#define SHOL_INSTRUMENT_CONCAT_(a, b) a##b
+#define SHOL_INSTRUMENT_CONCAT(a, b) SHOL_INSTRUMENT_CONCAT_(a, b)
+#define SHOL_INSTRUMENT_SCOPE(name)                                                               \
+    static ::shol::instrument::OpCounters& SHOL_INSTRUMENT_CONCAT(shol_op_, __LINE__) =          \
+        ::shol::instrument::op(name);                                                             \
+    ::shol::instrument::ScopedOp SHOL_INSTRUMENT_CONCAT(shol_scope_, __LINE__)(                   \
+        SHOL_INSTRUMENT_CONCAT(shol_op_, __LINE__))
+#define SHOL_INSTRUMENT_ALLOC(bytes)                                                              \
+    ::shol::instrument::ScopedOp::allocated(static_cast<uint64_t>(bytes))
+#define SHOL_INSTRUMENT_COPY(bytes) ::shol::instrument::ScopedOp::copied(static_cast<uint64_t>(bytes))
+
+#else
+
+constexpr bool enabled = false;
+
+inline Snapshot snapshot() { return Snapshot(); }
+inline void reset() {}
+
+#define SHOL_INSTRUMENT_SCOPE(name) ((void)0)
+#define SHOL_INSTRUMENT_ALLOC(bytes) ((void)0)
+#define SHOL_INSTRUMENT_COPY(bytes) ((void)0)
+
+#endif
+
+} // namespace instrument
+} // namespace shol
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace shol {
+
+// --------------------[ container ]--------------------
+// credits for is_container<> (https://gist.github.com/louisdx/1076849)
+
+template <typename T>
+struct has_const_iterator {
+private:
+    typedef char one;
+    typedef struct {
+        char array[2];
+    } two;
+
+    template <typename C>
+    static one test(typename C::const_iterator*);
+    template <typename C>
+    static two test(...);
+
+public:
+    static const bool value = sizeof(test<T>(0)) == sizeof(one);
+    typedef T type;
+};
+
+template <typename T>
+struct has_begin_end {
+    struct Dummy {
+        typedef void const_iterator;
+    };
+    typedef typename std::conditional<has_const_iterator<T>::value, T, Dummy>::type TType;
+    typedef typename TType::const_iterator iter;
+
+    struct Fallback {
+        iter begin() const;
+        iter end() const;
+    };
+    struct Derived : TType, Fallback {};
+
+    template <typename C, C>
+    struct ChT;
+
+    template <typename C>
+    static char (&f(ChT<iter (Fallback::*)() const, &C::begin>*))[1];
+    template <typename C>
+    static char (&f(...))[2];
+    template <typename C>
+    static char (&g(ChT<iter (Fallback::*)() const, &C::end>*))[1];
+    template <typename C>
+    static char (&g(...))[2];
+
+    static bool const beg_value = sizeof(f<Derived>(0)) == 2;
+    static bool const end_value = sizeof(g<Derived>(0)) == 2;
+};
+
+template <typename T>
+struct is_container {
+    static const bool value =
+        has_const_iterator<T>::value && has_begin_end<T>::beg_value && has_begin_end<T>::end_value;
+};
+
+// unordered_map, FlatHashSet, ... iterate in an order that depends on their history
+template <typename T>
+struct is_unordered {
+private:
+    template <typename C>
+    static char test(typename C::hasher*);
+    template <typename C>
+    static long test(...);
+
+public:
+    static const bool value = sizeof(test<T>(nullptr)) == sizeof(char);
+};
+
+// --------------------[ string ]--------------------
+// strings satisfy is_container<> but are usually treated as a single value.
+
+template <typename T>
+struct is_string : std::false_type {};
+
+template <class Ch, class Tr, class Alloc>
+struct is_string<std::basic_string<Ch, Tr, Alloc>> : std::true_type {};
+
+template <typename T>
+struct is_char
+    : std::integral_constant<bool, std::is_same<T, char>::value ||
+                                       std::is_same<T, wchar_t>::value ||
+                                       std::is_same<T, char16_t>::value ||
+                                       std::is_same<T, char32_t>::value> {};
+
+// --------------------[ insertion ]--------------------
+// sequences grow with push_back, sets and maps with insert
+
+template <typename T>
+struct has_push_back {
+private:
+    template <typename C>
+    static char
+    test(decltype(std::declval<C&>().push_back(std::declval<typename C::value_type>()))*);
+    template <typename C>
+    static long test(...);
+
+public:
+    static const bool value = sizeof(test<T>(nullptr)) == sizeof(char);
+};
+
+// map's value_type is pair<const K, V>, elements are built as pair<K, V> before insertion
+template <typename T>
+struct mutable_value {
+    typedef typename std::remove_const<T>::type type;
+};
+
+template <typename T1, typename T2>
+struct mutable_value<std::pair<T1, T2>> {
+    typedef std::pair<typename std::remove_const<T1>::type, T2> type;
+};
+
+template <class C>
+typename std::enable_if<has_push_back<C>::value>::type append(C& c, typename C::value_type&& x) {
+    c.push_back(std::move(x));
+}
+
+template <class C, class V>
+typename std::enable_if<!has_push_back<C>::value>::type append(C& c, V&& x) {
+    c.insert(std::forward<V>(x));
+}
+
+} // namespace shol